@@ -0,0 +1,148 @@
+#ifndef ASYNC_GENERATOR_HPP
+#define ASYNC_GENERATOR_HPP
+
+#include "ThreadPool.hpp"
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+// Asynchronous stream of values. The producer coroutine may co_await between co_yields; the consumer pulls with
+//     while (auto value = co_await stream.next()) { ... }
+// and gets an empty optional once the producer returns. Production is lazy: the body runs only while the consumer
+// waits on next(), and each value resumes the consumer on the thread that yielded it.
+template<typename T>
+class [[nodiscard]] AsyncGenerator {
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    struct promise_type {
+        std::optional<T> current;
+        std::coroutine_handle<> consumer;
+        std::exception_ptr error;
+
+        // Hands control back to the consumer waiting in next()
+        struct ConsumerResumer {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(Handle handle) noexcept { return handle.promise().consumer; }
+            void await_resume() noexcept {}
+        };
+
+        AsyncGenerator get_return_object() noexcept { return AsyncGenerator(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        ConsumerResumer final_suspend() noexcept { return {}; }
+        ConsumerResumer yield_value(T value) {
+            current.emplace(std::move(value));
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    struct NextAwaiter {
+        Handle producer;
+
+        bool await_ready() const noexcept { return !producer || producer.done(); }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) noexcept {
+            producer.promise().consumer = consumer;
+            producer.promise().current.reset();
+            return producer;
+        }
+        // Empty once the stream has ended; rethrows an exception that ended the producer
+        std::optional<T> await_resume() {
+            if (!producer) return std::nullopt;
+            promise_type& promise = producer.promise();
+            if (promise.error) std::rethrow_exception(std::exchange(promise.error, nullptr));
+            std::optional<T> value = std::move(promise.current);
+            promise.current.reset();
+            return value;
+        }
+    };
+
+private:
+    Handle handle;
+
+public:
+    explicit AsyncGenerator(Handle handle) : handle(handle) {}
+    AsyncGenerator(AsyncGenerator&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    AsyncGenerator& operator=(AsyncGenerator&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    AsyncGenerator(const AsyncGenerator&) = delete;
+    AsyncGenerator& operator=(const AsyncGenerator&) = delete;
+    // Only destroy a stream while no next() is pending
+    ~AsyncGenerator() {
+        if (handle) handle.destroy();
+    }
+
+    NextAwaiter next() { return NextAwaiter{handle}; }
+};
+
+// Unbounded multi-producer queue with one asynchronous consumer. It carries callbacks from engine threads into a
+// coroutine: push() never runs consumer code, a waiting consumer is resumed on the shared executor instead.
+template<typename T>
+class AsyncQueue {
+private:
+    std::mutex mutex;
+    std::deque<T> items;
+    bool closed = false;
+    std::coroutine_handle<> waiter;
+
+    static void resume(std::coroutine_handle<> consumer) {
+        if (consumer) ThreadPool::shared().post([consumer]() { consumer.resume(); });
+    }
+
+public:
+    struct PopAwaiter {
+        AsyncQueue& queue;
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> consumer) {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.items.empty() || queue.closed) return false;
+            queue.waiter = consumer;
+            return true;
+        }
+        // Empty once the queue is closed and drained
+        std::optional<T> await_resume() {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.items.empty()) return std::nullopt;
+            std::optional<T> item(std::move(queue.items.front()));
+            queue.items.pop_front();
+            return item;
+        }
+    };
+
+    // Ignored after close()
+    void push(T item) {
+        std::coroutine_handle<> consumer;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (closed) return;
+            items.push_back(std::move(item));
+            consumer = std::exchange(waiter, {});
+        }
+        resume(consumer);
+    }
+
+    void close() {
+        std::coroutine_handle<> consumer;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            consumer = std::exchange(waiter, {});
+        }
+        resume(consumer);
+    }
+
+    PopAwaiter pop() { return PopAwaiter{*this}; }
+};
+
+#endif // ASYNC_GENERATOR_HPP
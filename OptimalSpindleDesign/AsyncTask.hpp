@@ -0,0 +1,278 @@
+#ifndef ASYNC_TASK_HPP
+#define ASYNC_TASK_HPP
+
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// Coroutine building blocks of the asynchronous simulation API.
+//
+// A Task<T> starts eagerly: calling a coroutine runs it on the caller until its first suspension, and the library's
+// tasks suspend straight away by hopping to the shared executor, so the call launches the work and returns. co_await
+// on the task gives its result (or rethrows its exception) and resumes the awaiting coroutine on the thread that
+// finished the task. A task dropped without being awaited detaches and frees itself when it finishes.
+
+template<typename T = void>
+class Task;
+
+namespace detail {
+
+enum class TaskState { Running, Awaited, Finished, Detached };
+
+template<typename T>
+class TaskResult {
+private:
+    std::variant<std::monostate, T, std::exception_ptr> value;
+
+public:
+    template<typename U>
+    void return_value(U&& result) { value.template emplace<1>(std::forward<U>(result)); }
+    void unhandled_exception() { value.template emplace<2>(std::current_exception()); }
+    T take() {
+        if (value.index() == 2) std::rethrow_exception(std::get<2>(value));
+        return std::move(std::get<1>(value));
+    }
+};
+
+template<>
+class TaskResult<void> {
+private:
+    std::exception_ptr error;
+
+public:
+    void return_void() {}
+    void unhandled_exception() { error = std::current_exception(); }
+    void take() {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+template<typename T>
+struct TaskPromise : TaskResult<T> {
+    // Whoever of the finishing task and its awaiter (or destructor) comes second acts on the other's state
+    std::atomic<TaskState> state{TaskState::Running};
+    std::coroutine_handle<> continuation;
+
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<TaskPromise> handle) noexcept {
+            TaskPromise& promise = handle.promise();
+            TaskState previous = promise.state.exchange(TaskState::Finished, std::memory_order_acq_rel);
+            if (previous == TaskState::Awaited) return promise.continuation;
+            if (previous == TaskState::Detached) handle.destroy();
+            return std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+    };
+
+    Task<T> get_return_object() noexcept;
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    FinalAwaiter final_suspend() noexcept { return {}; }
+};
+
+// Fire-and-forget coroutine whose frame frees itself; the body must handle its own exceptions
+struct DetachedCoroutine {
+    struct promise_type {
+        DetachedCoroutine get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+// One-shot event. set() notifies under the lock, so the waiter may destroy the signal as soon as wait() returns.
+class Signal {
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool raised = false;
+
+public:
+    void set() {
+        std::lock_guard<std::mutex> lock(mutex);
+        raised = true;
+        condition.notify_all();
+    }
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this]() { return raised; });
+    }
+};
+
+} // namespace detail
+
+template<typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    void release() {
+        if (!handle) return;
+        if (handle.promise().state.exchange(detail::TaskState::Detached, std::memory_order_acq_rel) == detail::TaskState::Finished) {
+            handle.destroy();
+        }
+        handle = {};
+    }
+
+public:
+    struct Awaiter {
+        std::coroutine_handle<promise_type> handle;
+
+        bool await_ready() const noexcept {
+            return handle.promise().state.load(std::memory_order_acquire) == detail::TaskState::Finished;
+        }
+        // Returns false, resuming the awaiter at once, when the task finished after await_ready
+        bool await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            handle.promise().continuation = awaiting;
+            detail::TaskState expected = detail::TaskState::Running;
+            return handle.promise().state.compare_exchange_strong(expected, detail::TaskState::Awaited, std::memory_order_acq_rel);
+        }
+        T await_resume() { return handle.promise().take(); }
+    };
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            release();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { release(); }
+
+    bool ready() const { return handle && handle.promise().state.load(std::memory_order_acquire) == detail::TaskState::Finished; }
+
+    // Lets the task run to completion unobserved; its result and any exception are discarded
+    void detach() { release(); }
+
+    // A task is awaited at most once
+    Awaiter operator co_await() noexcept { return Awaiter{handle}; }
+};
+
+template<typename T>
+Task<T> detail::TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+}
+
+// co_await resumeOn(pool) continues the coroutine on a worker of pool
+struct PoolResumer {
+    ThreadPool& pool;
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { pool.post([handle]() { handle.resume(); }); }
+    void await_resume() const noexcept {}
+};
+
+inline PoolResumer resumeOn(ThreadPool& pool) { return PoolResumer{pool}; }
+
+// Single-threaded executor for a controller thread. Coroutines co_await resumeOn(loop) to continue on the thread
+// inside run(), so one thread can multiplex any number of in-flight simulations while their work runs on the pool.
+class EventLoop {
+private:
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::coroutine_handle<>> ready;
+    size_t outstanding = 0;   // Spawned tasks not yet finished
+    std::exception_ptr error; // First exception escaping a spawned task
+
+    static detail::DetachedCoroutine track(EventLoop& loop, Task<void> task) {
+        std::exception_ptr failure;
+        try {
+            co_await task;
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(loop.mutex);
+        if (failure && !loop.error) loop.error = failure;
+        --loop.outstanding;
+        loop.wake.notify_all();
+    }
+
+public:
+    EventLoop() = default;
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    // Queues a suspended coroutine to be resumed by run(); callable from any thread
+    void post(std::coroutine_handle<> handle) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ready.push_back(handle);
+        }
+        wake.notify_one();
+    }
+
+    // Keeps task running under the loop; run() returns once every spawned task has finished
+    void spawn(Task<void> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++outstanding;
+        }
+        track(*this, std::move(task));
+    }
+
+    // Resumes queued coroutines on the calling thread until no spawned task is left, then rethrows the first
+    // exception that escaped a spawned task
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [this]() { return !ready.empty() || outstanding == 0; });
+            if (ready.empty()) break;
+            std::coroutine_handle<> next = ready.front();
+            ready.pop_front();
+            lock.unlock();
+            next.resume();
+            lock.lock();
+        }
+        if (error) std::rethrow_exception(std::exchange(error, nullptr));
+    }
+};
+
+struct LoopResumer {
+    EventLoop& loop;
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { loop.post(handle); }
+    void await_resume() const noexcept {}
+};
+
+inline LoopResumer resumeOn(EventLoop& loop) { return LoopResumer{loop}; }
+
+// Blocks the calling thread until task finishes and returns its result. Must not be called from a worker the task
+// depends on.
+template<typename T>
+T syncWait(Task<T> task) {
+    detail::TaskResult<T> outcome;
+    detail::Signal done;
+    auto waiter = [](Task<T>& task, detail::TaskResult<T>& outcome, detail::Signal& done) -> detail::DetachedCoroutine {
+        try {
+            if constexpr (std::is_void_v<T>) {
+                co_await task;
+                outcome.return_void();
+            } else {
+                outcome.return_value(co_await task);
+            }
+        } catch (...) {
+            outcome.unhandled_exception();
+        }
+        done.set();
+    };
+    waiter(task, outcome, done);
+    done.wait();
+    return outcome.take();
+}
+
+#endif // ASYNC_TASK_HPP
@@ -0,0 +1,301 @@
+#include "BenchmarkHarness.hpp"
+#include "BenchmarkProblems.hpp"
+#include "SearchAlgorithms.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+struct BenchmarkResult {
+    std::string problem;
+    size_t objectives = 0;
+    std::vector<double> hypervolumeRatios;
+    std::vector<double> initialRatios;      // Hypervolume ratio of the initial population's first front
+    std::vector<double> targetGenerations;  // First generation reaching settings.targetRatio, for the runs that did
+    std::vector<double> distances;          // IGD against the sampled reference front
+    std::vector<double> dominanceDistances; // IGD+
+    std::vector<double> evaluationRates;    // Evaluations per second of wall-clock time
+};
+
+using BenchmarkRunner = std::function<BenchmarkResult(const BenchmarkSettings&)>;
+
+template<typename Problem>
+BenchmarkResult runProblem(const BenchmarkSettings& settings) {
+    const size_t M = Problem::objectiveCount;
+    BenchmarkResult result;
+    result.problem = Problem::name();
+    result.objectives = M;
+
+    // Normalize by the true front so hypervolumes are comparable across problems
+    PointSet referenceFront = Problem::referenceFront(M == 2 ? 500 : 1000);
+    std::vector<double> ideal(M, std::numeric_limits<double>::infinity());
+    std::vector<double> nadir(M, -std::numeric_limits<double>::infinity());
+    for (const auto& point : referenceFront) {
+        for (size_t i = 0; i < M; ++i) {
+            ideal[i] = std::min(ideal[i], point[i]);
+            nadir[i] = std::max(nadir[i], point[i]);
+        }
+    }
+    std::vector<double> referencePoint(M, 1.1);
+    double optimalVolume = hypervolume(normalizePoints(referenceFront, ideal, nadir), referencePoint);
+
+    auto ratioOf = [&](const PointSet& front) {
+        return optimalVolume > 0.0 ? hypervolume(normalizePoints(front, ideal, nadir), referencePoint) / optimalVolume : 0.0;
+    };
+
+    Problem problem;
+    for (unsigned int seed : settings.seeds) {
+        // Each generation's front is copied during the run and scored after it, keeping hypervolumes out of the timing
+        std::vector<PointSet> generationFronts;
+        SearchHooks<Problem> hooks;
+        hooks.frontObserver = [&generationFronts](int generation, const std::vector<std::array<double, Problem::objectiveCount>>& front) {
+            if (generationFronts.size() <= static_cast<size_t>(generation)) generationFronts.resize(generation + 1);
+            for (const auto& point : front) generationFronts[generation].emplace_back(point.begin(), point.end());
+        };
+        auto start = std::chrono::steady_clock::now();
+        SearchResult<Problem> search = runSearch(problem, settings.optimizer, seed, settings.populationSize, settings.generations, hooks);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (!generationFronts.empty()) result.initialRatios.push_back(ratioOf(generationFronts.front()));
+        for (size_t generation = 0; generation < generationFronts.size(); ++generation) {
+            if (ratioOf(generationFronts[generation]) >= settings.targetRatio) {
+                result.targetGenerations.push_back(static_cast<double>(generation));
+                break;
+            }
+        }
+
+        PointSet front;
+        for (const auto& entry : search.front) front.emplace_back(entry.objectives.begin(), entry.objectives.end());
+        result.hypervolumeRatios.push_back(ratioOf(front));
+        result.distances.push_back(invertedGenerationalDistance(front, referenceFront));
+        result.dominanceDistances.push_back(invertedGenerationalDistancePlus(front, referenceFront));
+        result.evaluationRates.push_back(search.evaluations / std::max(elapsed, 1e-9));
+    }
+    return result;
+}
+
+const std::vector<std::pair<std::string, BenchmarkRunner>>& benchmarkRegistry() {
+    static const std::vector<std::pair<std::string, BenchmarkRunner>> registry = {
+        {"ZDT1", runProblem<Zdt<1>>}, {"ZDT2", runProblem<Zdt<2>>}, {"ZDT3", runProblem<Zdt<3>>},
+        {"ZDT4", runProblem<Zdt<4>>}, {"ZDT5", runProblem<Zdt<5>>}, {"ZDT6", runProblem<Zdt<6>>},
+        {"DTLZ1", runProblem<Dtlz<1>>}, {"DTLZ2", runProblem<Dtlz<2>>}, {"DTLZ3", runProblem<Dtlz<3>>},
+        {"DTLZ4", runProblem<Dtlz<4>>}, {"DTLZ5", runProblem<Dtlz<5>>}, {"DTLZ6", runProblem<Dtlz<6>>},
+        {"DTLZ7", runProblem<Dtlz<7>>},
+        {"WFG1", runProblem<Wfg<1>>}, {"WFG2", runProblem<Wfg<2>>}, {"WFG3", runProblem<Wfg<3>>},
+        {"WFG4", runProblem<Wfg<4>>}, {"WFG5", runProblem<Wfg<5>>}, {"WFG6", runProblem<Wfg<6>>},
+        {"WFG7", runProblem<Wfg<7>>}, {"WFG8", runProblem<Wfg<8>>}, {"WFG9", runProblem<Wfg<9>>}
+    };
+    return registry;
+}
+
+double mean(const std::vector<double>& values) {
+    return values.empty() ? 0.0 : std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+
+double standardDeviation(const std::vector<double>& values) {
+    if (values.size() < 2) return 0.0;
+    double average = mean(values);
+    double sum = 0.0;
+    for (double value : values) sum += (value - average) * (value - average);
+    return std::sqrt(sum / (values.size() - 1));
+}
+
+// Operating states spread over the ranges the simulation produces, labelled by the same thresholds as its seed data
+MaintenanceRecord randomMaintenanceRecord(std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double vibration = 0.2 + unit(rng) * 2.0;
+    double temperature = 20.0 + unit(rng) * 30.0;
+    double load = 500.0 + unit(rng) * 1500.0;
+    double bearingLife = 1000.0 + unit(rng) * 49000.0;
+    double spindleLife = unit(rng);
+    double wheelWear = unit(rng) * 40.0;
+    int label = (vibration > 1.0 || bearingLife < 5000 || spindleLife < 0.5 || wheelWear > 20.0) ? 1 : 0;
+    return MaintenanceRecord(vibration, temperature, load, bearingLife, spindleLife, wheelWear, label);
+}
+
+struct HistoryPhase {
+    double readsPerSecond = 0.0;
+    double appendsPerSecond = 0.0;
+    double medianMicros = 0.0;
+    double tailMicros = 0.0;  // 99th percentile
+};
+
+// Runs readers, and writers when asked, against history for the given time. Plain threads rather than the shared
+// executor, whose workers would otherwise sit in these loops for the whole phase.
+HistoryPhase runHistoryPhase(MaintenanceHistory& history, const HistoryBenchmarkSettings& settings, size_t readers, size_t writers) {
+    const size_t k = 3;
+    const size_t sampleEvery = 16;  // Queries timed individually, to keep clock reads out of the throughput
+    std::atomic<bool> stop{false};
+    std::vector<uint64_t> reads(readers, 0);
+    std::vector<uint64_t> appends(writers, 0);
+    std::vector<std::vector<float>> latencies(readers);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < readers; ++t) {
+        threads.emplace_back([&, t]() {
+            std::mt19937_64 rng(settings.seed * 7919 + t);
+            MaintenanceIndex::Neighbor best[k];
+            uint64_t count = 0;  // Shared counters would put the readers on one cache line
+            while (!stop.load(std::memory_order_relaxed)) {
+                MaintenanceRecord query = randomMaintenanceRecord(rng);
+                if (count % sampleEvery == 0) {
+                    auto started = std::chrono::steady_clock::now();
+                    history.nearest(query, k, best);
+                    latencies[t].push_back(std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - started).count());
+                } else {
+                    history.nearest(query, k, best);
+                }
+                ++count;
+            }
+            reads[t] = count;
+        });
+    }
+    for (size_t t = 0; t < writers; ++t) {
+        threads.emplace_back([&, t]() {
+            std::mt19937_64 rng(settings.seed * 104729 + t);
+            uint64_t count = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                history.append(randomMaintenanceRecord(rng));
+                ++count;
+            }
+            appends[t] = count;
+        });
+    }
+    auto started = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::duration<double>(settings.seconds));
+    stop = true;
+    for (auto& thread : threads) thread.join();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    HistoryPhase phase;
+    phase.readsPerSecond = std::accumulate(reads.begin(), reads.end(), uint64_t(0)) / elapsed;
+    phase.appendsPerSecond = std::accumulate(appends.begin(), appends.end(), uint64_t(0)) / elapsed;
+    std::vector<float> samples;
+    for (const auto& latency : latencies) samples.insert(samples.end(), latency.begin(), latency.end());
+    if (!samples.empty()) {
+        std::sort(samples.begin(), samples.end());
+        phase.medianMicros = samples[samples.size() / 2];
+        phase.tailMicros = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+    }
+    return phase;
+}
+}
+
+std::vector<std::string> benchmarkProblemNames() {
+    std::vector<std::string> names;
+    for (const auto& entry : benchmarkRegistry()) names.push_back(entry.first);
+    return names;
+}
+
+std::string runBenchmarkSuite(const BenchmarkSettings& settings) {
+    try {
+        if (settings.populationSize < 2 || settings.generations < 1) {
+            throw std::invalid_argument("Population size must be at least 2 and generations at least 1");
+        }
+        if (settings.seeds.empty()) {
+            throw std::invalid_argument("At least one seed is required");
+        }
+        std::vector<std::string> known = benchmarkProblemNames();
+        for (const auto& name : settings.problems) {
+            if (std::find(known.begin(), known.end(), name) == known.end()) {
+                throw std::invalid_argument("Unknown benchmark problem: " + name);
+            }
+        }
+        std::vector<const std::pair<std::string, BenchmarkRunner>*> selected;
+        for (const auto& entry : benchmarkRegistry()) {
+            if (settings.problems.empty() ||
+                std::find(settings.problems.begin(), settings.problems.end(), entry.first) != settings.problems.end()) {
+                selected.push_back(&entry);
+            }
+        }
+
+        std::ostringstream report;
+        report << "=== Optimizer Benchmark Results ===\n\n";
+        report << "Algorithm: " << searchAlgorithmName(settings.optimizer.algorithm) << "\n";
+        report << "Population: " << settings.populationSize << ", generations: " << settings.generations
+               << ", runs per problem: " << settings.seeds.size() << "\n";
+        report << "Initialization: " << (settings.optimizer.initialization == InitializationMethod::Random ? "random" : "Latin hypercube")
+               << ", parameter control: " << (settings.optimizer.parameterControl == ParameterControl::Fixed ? "fixed" : "success history") << "\n";
+        report << "Hypervolume ratio uses objectives normalized by the true front and reference point 1.1\n";
+        report << "HV@0 is the initial population's ratio; Gens is the mean first generation reaching a ratio of "
+               << settings.targetRatio << " over the runs that reached it\n\n";
+        report << std::fixed;
+        report << std::setw(8) << "Problem" << std::setw(6) << "M"
+               << std::setw(12) << "HV Ratio" << std::setw(10) << "(std)"
+               << std::setw(10) << "HV@0" << std::setw(10) << "Gens" << std::setw(10) << "(runs)"
+               << std::setw(12) << "IGD" << std::setw(10) << "(std)"
+               << std::setw(12) << "IGD+" << std::setw(10) << "(std)"
+               << std::setw(14) << "Evals/s" << "\n";
+        for (const auto* entry : selected) {
+            BenchmarkResult result = entry->second(settings);
+            report << std::setw(8) << result.problem << std::setw(6) << result.objectives
+                   << std::setprecision(4)
+                   << std::setw(12) << mean(result.hypervolumeRatios) << std::setw(10) << standardDeviation(result.hypervolumeRatios)
+                   << std::setw(10) << mean(result.initialRatios)
+                   << std::setprecision(1) << std::setw(10);
+            if (result.targetGenerations.empty()) report << "-";
+            else report << mean(result.targetGenerations);
+            report
+                   << std::setw(10) << (std::to_string(result.targetGenerations.size()) + "/" + std::to_string(settings.seeds.size()))
+                   << std::setprecision(4)
+                   << std::setw(12) << mean(result.distances) << std::setw(10) << standardDeviation(result.distances)
+                   << std::setw(12) << mean(result.dominanceDistances) << std::setw(10) << standardDeviation(result.dominanceDistances)
+                   << std::setprecision(0) << std::setw(14) << mean(result.evaluationRates) << "\n";
+        }
+        return report.str();
+    } catch (const std::exception& e) {
+        return "Error: Benchmark failed - " + std::string(e.what()) + "\n";
+    }
+}
+
+std::string runHistoryBenchmark(const HistoryBenchmarkSettings& settings) {
+    try {
+        if (settings.records < 2 || settings.seconds <= 0.0) {
+            throw std::invalid_argument("The history needs at least 2 records and each phase a positive duration");
+        }
+        size_t hardware = std::max<unsigned int>(1, std::thread::hardware_concurrency());
+        size_t readers = settings.readers > 0 ? settings.readers : std::max<size_t>(1, hardware - std::min(hardware, settings.writers));
+
+        HistoryRetention retention;
+        retention.capacity = settings.records;
+        retention.search = settings.search;
+        MaintenanceHistory history(retention, settings.seed);
+        std::mt19937_64 rng(settings.seed);
+        std::vector<MaintenanceRecord> batch;
+        for (size_t loaded = 0; loaded < settings.records; loaded += batch.size()) {
+            batch.clear();
+            for (size_t i = loaded; i < std::min(settings.records, loaded + 65536); ++i) batch.push_back(randomMaintenanceRecord(rng));
+            history.appendAll(batch);
+        }
+
+        HistoryPhase idle = runHistoryPhase(history, settings, readers, 0);
+        HistoryPhase loaded = runHistoryPhase(history, settings, readers, settings.writers);
+
+        std::ostringstream report;
+        report << "=== Maintenance History Concurrency Benchmark ===\n\n";
+        report << "Records: " << history.size() << ", search: " << (settings.search == NeighborSearch::Hnsw ? "HNSW" : "kd-tree")
+               << ", readers: " << readers << ", writers: " << settings.writers << ", " << settings.seconds << " s per phase\n\n";
+        report << std::fixed;
+        report << std::setw(14) << "Phase" << std::setw(14) << "Reads/s" << std::setw(12) << "p50 (us)"
+               << std::setw(12) << "p99 (us)" << std::setw(14) << "Appends/s" << "\n";
+        auto row = [&report](const char* name, const HistoryPhase& phase) {
+            report << std::setw(14) << name << std::setprecision(0) << std::setw(14) << phase.readsPerSecond
+                   << std::setprecision(2) << std::setw(12) << phase.medianMicros << std::setw(12) << phase.tailMicros
+                   << std::setprecision(0) << std::setw(14) << phase.appendsPerSecond << "\n";
+        };
+        row("Reads only", idle);
+        row("With writers", loaded);
+        report << std::setprecision(1) << "\nRead throughput under writes: "
+               << (idle.readsPerSecond > 0.0 ? 100.0 * loaded.readsPerSecond / idle.readsPerSecond : 0.0) << "% of reads only\n";
+        return report.str();
+    } catch (const std::exception& e) {
+        return "Error: Benchmark failed - " + std::string(e.what()) + "\n";
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef BENCHMARK_HARNESS_HPP
+#define BENCHMARK_HARNESS_HPP
+
+#include "MaintenanceHistory.hpp"
+#include "OptimizationSettings.hpp"
+#include <string>
+#include <vector>
+
+struct BenchmarkSettings {
+    std::vector<std::string> problems;  // Problem names such as "ZDT1" or "WFG4" (empty = whole suite)
+    int populationSize;
+    int generations;
+    std::vector<unsigned int> seeds;    // One independent run per seed
+    double targetRatio;                 // Hypervolume ratio whose first generation is reported
+    OptimizationSettings optimizer;     // Engine configuration under test
+
+    // Default constructor
+    BenchmarkSettings() : populationSize(100), generations(200), seeds{1, 2, 3, 4, 5}, targetRatio(0.8) {}
+};
+
+// Names of every registered benchmark problem, in suite order
+std::vector<std::string> benchmarkProblemNames();
+
+// Runs the optimizer on the selected ZDT/DTLZ/WFG problems and reports hypervolume ratio, initial hypervolume ratio,
+// generations to the target ratio, IGD, IGD+ and throughput per problem
+std::string runBenchmarkSuite(const BenchmarkSettings& settings);
+
+struct HistoryBenchmarkSettings {
+    size_t records = 100000;   // History size, loaded before the run; also its capacity
+    size_t readers = 0;        // Query threads (0 = one per hardware thread not taken by a writer)
+    size_t writers = 1;        // Threads appending throughout the loaded phase
+    double seconds = 2.0;      // Length of each phase
+    NeighborSearch search = NeighborSearch::KdTree;
+    unsigned int seed = 1;
+};
+
+// Measures maintenance-history query throughput and latency with no writers, then again while writers append
+// continuously, and reports the append rate reached meanwhile
+std::string runHistoryBenchmark(const HistoryBenchmarkSettings& settings);
+
+#endif // BENCHMARK_HARNESS_HPP
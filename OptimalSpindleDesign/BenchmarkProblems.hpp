@@ -0,0 +1,496 @@
+#ifndef BENCHMARK_PROBLEMS_HPP
+#define BENCHMARK_PROBLEMS_HPP
+
+#include "MogaEngine.hpp"
+#include "ParetoMetrics.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+// Standard test problems with known Pareto fronts (ZDT, DTLZ, WFG) for measuring MogaEngine changes.
+// Every problem maps its normalized genome onto the published variable ranges and provides referenceFront().
+
+namespace benchmark_detail {
+constexpr double pi = 3.14159265358979323846;
+
+// Das-Dennis lattice on the unit simplex with as many divisions as fit into the sample budget
+inline PointSet simplexLattice(size_t objectives, size_t samples) {
+    auto latticeSize = [objectives](size_t divisions) {
+        double count = 1.0;
+        for (size_t i = 1; i < objectives; ++i) count = count * (divisions + i) / i;
+        return count;
+    };
+    size_t divisions = 1;
+    while (latticeSize(divisions + 1) <= static_cast<double>(samples)) ++divisions;
+
+    PointSet points;
+    std::vector<size_t> counts(objectives, 0);
+    std::function<void(size_t, size_t)> fill = [&](size_t index, size_t left) {
+        if (index + 1 == objectives) {
+            counts[index] = left;
+            std::vector<double> point(objectives);
+            for (size_t i = 0; i < objectives; ++i) point[i] = static_cast<double>(counts[i]) / divisions;
+            points.push_back(point);
+            return;
+        }
+        for (size_t c = 0; c <= left; ++c) {
+            counts[index] = c;
+            fill(index + 1, left - c);
+        }
+    };
+    fill(0, divisions);
+    return points;
+}
+
+inline PointSet sphereLattice(size_t objectives, size_t samples) {
+    PointSet points = simplexLattice(objectives, samples);
+    for (auto& point : points) {
+        double norm = 0.0;
+        for (double value : point) norm += value * value;
+        norm = std::sqrt(norm);
+        for (double& value : point) value /= norm;
+    }
+    return points;
+}
+
+// Regular grid over [0, 1]^dimensions with roughly the requested number of points
+inline PointSet unitGrid(size_t dimensions, size_t samples) {
+    if (dimensions == 0) return PointSet(1);
+    size_t perAxis = std::max<size_t>(2, static_cast<size_t>(std::pow(static_cast<double>(samples), 1.0 / dimensions)));
+    PointSet points;
+    std::vector<size_t> index(dimensions, 0);
+    while (true) {
+        std::vector<double> point(dimensions);
+        for (size_t i = 0; i < dimensions; ++i) point[i] = static_cast<double>(index[i]) / (perAxis - 1);
+        points.push_back(point);
+        size_t axis = 0;
+        while (axis < dimensions && ++index[axis] == perAxis) index[axis++] = 0;
+        if (axis == dimensions) break;
+    }
+    return points;
+}
+
+inline double clampUnit(double value) {
+    return std::max(0.0, std::min(1.0, value));
+}
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// ZDT (Zitzler, Deb, Thiele 2000)
+// ---------------------------------------------------------------------------------------------------------------
+
+template<int Variant>
+class Zdt {
+    static_assert(Variant >= 1 && Variant <= 6, "ZDT variants are 1-6");
+
+public:
+    static constexpr std::size_t objectiveCount = 2;
+    static constexpr std::size_t continuousGenes = Variant == 5 ? 0 : (Variant == 4 || Variant == 6 ? 10 : 30);
+    static constexpr std::size_t categoricalGenes = Variant == 5 ? 80 : 0; // ZDT5: one 30-bit and ten 5-bit strings
+    static constexpr std::array<int, categoricalGenes> categoryCounts = [] {
+        std::array<int, categoricalGenes> counts{};
+        counts.fill(2);
+        return counts;
+    }();
+
+    using GenomeType = Genome<continuousGenes, categoricalGenes>;
+    using Objectives = std::array<double, objectiveCount>;
+
+    static const char* name() {
+        static const char* names[] = {"ZDT1", "ZDT2", "ZDT3", "ZDT4", "ZDT5", "ZDT6"};
+        return names[Variant - 1];
+    }
+
+    void evaluate(const GenomeType& genome, Objectives& objectives, std::mt19937&) const {
+        using benchmark_detail::pi;
+        if constexpr (Variant == 5) {
+            auto ones = [&](size_t first, size_t count) {
+                int total = 0;
+                for (size_t i = first; i < first + count; ++i) total += genome.categorical[i];
+                return total;
+            };
+            double f1 = 1.0 + ones(0, 30);
+            double g = 0.0;
+            for (size_t group = 0; group < 10; ++group) {
+                int u = ones(30 + 5 * group, 5);
+                g += u < 5 ? 2.0 + u : 1.0;
+            }
+            objectives = {f1, g / f1};
+        } else {
+            const auto& x = genome.continuous;
+            const size_t n = continuousGenes;
+            double f1 = x[0];
+            double g = 0.0;
+            if constexpr (Variant == 4) {
+                g = 1.0 + 10.0 * (n - 1);
+                for (size_t i = 1; i < n; ++i) {
+                    double xi = -5.0 + 10.0 * x[i];
+                    g += xi * xi - 10.0 * std::cos(4.0 * pi * xi);
+                }
+            } else if constexpr (Variant == 6) {
+                f1 = 1.0 - std::exp(-4.0 * x[0]) * std::pow(std::sin(6.0 * pi * x[0]), 6);
+                double sum = 0.0;
+                for (size_t i = 1; i < n; ++i) sum += x[i];
+                g = 1.0 + 9.0 * std::pow(sum / (n - 1), 0.25);
+            } else {
+                double sum = 0.0;
+                for (size_t i = 1; i < n; ++i) sum += x[i];
+                g = 1.0 + 9.0 * sum / (n - 1);
+            }
+            double ratio = f1 / g;
+            double h = 0.0;
+            if constexpr (Variant == 2 || Variant == 6) h = 1.0 - ratio * ratio;
+            else if constexpr (Variant == 3) h = 1.0 - std::sqrt(ratio) - ratio * std::sin(10.0 * pi * f1);
+            else h = 1.0 - std::sqrt(ratio);
+            objectives = {f1, g * h};
+        }
+    }
+
+    static PointSet referenceFront(size_t samples) {
+        using benchmark_detail::pi;
+        PointSet front;
+        if constexpr (Variant == 5) {
+            for (int u = 0; u <= 30; ++u) front.push_back({1.0 + u, 10.0 / (1.0 + u)});
+            return front;
+        }
+        double lower = Variant == 6 ? 0.2807753191 : 0.0;
+        for (size_t i = 0; i < samples; ++i) {
+            double f1 = lower + (1.0 - lower) * i / (samples - 1);
+            double f2 = 0.0;
+            if constexpr (Variant == 2 || Variant == 6) f2 = 1.0 - f1 * f1;
+            else if constexpr (Variant == 3) f2 = 1.0 - std::sqrt(f1) - f1 * std::sin(10.0 * pi * f1);
+            else f2 = 1.0 - std::sqrt(f1);
+            front.push_back({f1, f2});
+        }
+        return Variant == 3 ? nonDominatedFilter(front) : front;
+    }
+};
+
+// ---------------------------------------------------------------------------------------------------------------
+// DTLZ (Deb, Thiele, Laumanns, Zitzler 2002), scalable in the number of objectives
+// ---------------------------------------------------------------------------------------------------------------
+
+template<int Variant, std::size_t M = 3>
+class Dtlz {
+    static_assert(Variant >= 1 && Variant <= 7, "DTLZ variants are 1-7");
+    static_assert(M >= 2, "DTLZ needs at least two objectives");
+
+public:
+    static constexpr std::size_t distanceGenes = Variant == 1 ? 5 : (Variant == 7 ? 20 : 10);
+    static constexpr std::size_t objectiveCount = M;
+    static constexpr std::size_t continuousGenes = M - 1 + distanceGenes;
+    static constexpr std::size_t categoricalGenes = 0;
+    static constexpr std::array<int, categoricalGenes> categoryCounts = {};
+
+    using GenomeType = Genome<continuousGenes, categoricalGenes>;
+    using Objectives = std::array<double, objectiveCount>;
+
+    static const char* name() {
+        static const char* names[] = {"DTLZ1", "DTLZ2", "DTLZ3", "DTLZ4", "DTLZ5", "DTLZ6", "DTLZ7"};
+        return names[Variant - 1];
+    }
+
+    void evaluate(const GenomeType& genome, Objectives& objectives, std::mt19937&) const {
+        using benchmark_detail::pi;
+        const auto& x = genome.continuous;
+
+        double g = 0.0;
+        for (size_t i = M - 1; i < continuousGenes; ++i) {
+            if constexpr (Variant == 1 || Variant == 3) {
+                g += (x[i] - 0.5) * (x[i] - 0.5) - std::cos(20.0 * pi * (x[i] - 0.5));
+            } else if constexpr (Variant == 6) {
+                g += std::pow(x[i], 0.1);
+            } else {
+                g += (Variant == 7) ? x[i] : (x[i] - 0.5) * (x[i] - 0.5);
+            }
+        }
+        if constexpr (Variant == 1 || Variant == 3) g = 100.0 * (distanceGenes + g);
+        if constexpr (Variant == 7) g = 1.0 + 9.0 * g / distanceGenes;
+
+        if constexpr (Variant == 1) {
+            for (size_t m = 0; m < M; ++m) {
+                double f = 0.5 * (1.0 + g);
+                for (size_t j = 0; j + 1 + m < M; ++j) f *= x[j];
+                if (m > 0) f *= 1.0 - x[M - 1 - m];
+                objectives[m] = f;
+            }
+        } else if constexpr (Variant == 7) {
+            double h = static_cast<double>(M);
+            for (size_t m = 0; m + 1 < M; ++m) {
+                objectives[m] = x[m];
+                h -= x[m] / (1.0 + g) * (1.0 + std::sin(3.0 * pi * x[m]));
+            }
+            objectives[M - 1] = (1.0 + g) * h;
+        } else {
+            std::array<double, M - 1> theta{};
+            for (size_t j = 0; j + 1 < M; ++j) {
+                if constexpr (Variant == 4) theta[j] = std::pow(x[j], 100.0);
+                else if constexpr (Variant == 5 || Variant == 6) theta[j] = j == 0 ? x[0] : (1.0 + 2.0 * g * x[j]) / (2.0 * (1.0 + g));
+                else theta[j] = x[j];
+            }
+            for (size_t m = 0; m < M; ++m) {
+                double f = 1.0 + g;
+                for (size_t j = 0; j + 1 + m < M; ++j) f *= std::cos(theta[j] * pi / 2.0);
+                if (m > 0) f *= std::sin(theta[M - 1 - m] * pi / 2.0);
+                objectives[m] = f;
+            }
+        }
+    }
+
+    static PointSet referenceFront(size_t samples) {
+        using benchmark_detail::pi;
+        if constexpr (Variant == 1) {
+            PointSet front = benchmark_detail::simplexLattice(M, samples);
+            for (auto& point : front) {
+                for (double& value : point) value *= 0.5;
+            }
+            return front;
+        } else if constexpr (Variant == 5 || Variant == 6) {
+            // Degenerate curve: every angle but the first sits at pi/4 when g = 0
+            PointSet front;
+            for (size_t i = 0; i < samples; ++i) {
+                double first = static_cast<double>(i) / (samples - 1);
+                std::vector<double> point(M);
+                for (size_t m = 0; m < M; ++m) {
+                    double f = 1.0;
+                    for (size_t j = 0; j + 1 + m < M; ++j) f *= std::cos((j == 0 ? first : 0.5) * pi / 2.0);
+                    if (m > 0) f *= std::sin((M - 1 - m == 0 ? first : 0.5) * pi / 2.0);
+                    point[m] = f;
+                }
+                front.push_back(point);
+            }
+            return front;
+        } else if constexpr (Variant == 7) {
+            PointSet front;
+            for (const auto& position : benchmark_detail::unitGrid(M - 1, samples)) {
+                std::vector<double> point(position);
+                double h = static_cast<double>(M);
+                for (double value : position) h -= value / 2.0 * (1.0 + std::sin(3.0 * pi * value));
+                point.push_back(2.0 * h);
+                front.push_back(point);
+            }
+            return nonDominatedFilter(front);
+        } else {
+            return benchmark_detail::sphereLattice(M, samples);
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------------------------------------------
+// WFG (Huband, Hingston, Barone, While 2006) with k = 2(M - 1) position and 20 distance parameters
+// ---------------------------------------------------------------------------------------------------------------
+
+struct WfgTransforms {
+    static double bPoly(double y, double alpha) {
+        return benchmark_detail::clampUnit(std::pow(y, alpha));
+    }
+    static double bFlat(double y, double a, double b, double c) {
+        double value = a + std::min(0.0, std::floor(y - b)) * a * (b - y) / b
+                         - std::min(0.0, std::floor(c - y)) * (1.0 - a) * (y - c) / (1.0 - c);
+        return benchmark_detail::clampUnit(value);
+    }
+    static double bParam(double y, double u, double a, double b, double c) {
+        double exponent = b + (c - b) * (a - (1.0 - 2.0 * u) * std::abs(std::floor(0.5 - u) + a));
+        return benchmark_detail::clampUnit(std::pow(y, exponent));
+    }
+    static double sLinear(double y, double a) {
+        return benchmark_detail::clampUnit(std::abs(y - a) / std::abs(std::floor(a - y) + a));
+    }
+    static double sDecept(double y, double a, double b, double c) {
+        double tmp1 = std::floor(y - a + b) * (1.0 - c + (a - b) / b) / (a - b);
+        double tmp2 = std::floor(a + b - y) * (1.0 - c + (1.0 - a - b) / b) / (1.0 - a - b);
+        return benchmark_detail::clampUnit(1.0 + (std::abs(y - a) - b) * (tmp1 + tmp2 + 1.0 / b));
+    }
+    static double sMulti(double y, double a, double b, double c) {
+        double tmp1 = std::abs(y - c) / (2.0 * (std::floor(c - y) + c));
+        double tmp2 = (4.0 * a + 2.0) * benchmark_detail::pi * (0.5 - tmp1);
+        return benchmark_detail::clampUnit((1.0 + std::cos(tmp2) + 4.0 * b * tmp1 * tmp1) / (b + 2.0));
+    }
+    static double rSum(const std::vector<double>& y, const std::vector<double>& weights) {
+        double numerator = 0.0;
+        double denominator = 0.0;
+        for (size_t i = 0; i < y.size(); ++i) {
+            numerator += weights[i] * y[i];
+            denominator += weights[i];
+        }
+        return benchmark_detail::clampUnit(numerator / denominator);
+    }
+    static double rNonsep(const std::vector<double>& y, size_t a) {
+        size_t n = y.size();
+        double numerator = 0.0;
+        for (size_t j = 0; j < n; ++j) {
+            numerator += y[j];
+            for (size_t k = 0; k + 2 <= a; ++k) numerator += std::abs(y[j] - y[(j + k + 1) % n]);
+        }
+        double half = std::ceil(a / 2.0);
+        double denominator = (static_cast<double>(n) / a) * half * (1.0 + 2.0 * a - 2.0 * half);
+        return benchmark_detail::clampUnit(numerator / denominator);
+    }
+};
+
+template<int Variant, std::size_t M = 3>
+class Wfg {
+    static_assert(Variant >= 1 && Variant <= 9, "WFG variants are 1-9");
+    static_assert(M >= 2, "WFG needs at least two objectives");
+
+public:
+    static constexpr std::size_t positionGenes = 2 * (M - 1);
+    static constexpr std::size_t distanceGenes = 20;
+    static constexpr std::size_t objectiveCount = M;
+    static constexpr std::size_t continuousGenes = positionGenes + distanceGenes;
+    static constexpr std::size_t categoricalGenes = 0;
+    static constexpr std::array<int, categoricalGenes> categoryCounts = {};
+
+    using GenomeType = Genome<continuousGenes, categoricalGenes>;
+    using Objectives = std::array<double, objectiveCount>;
+
+    static const char* name() {
+        static const char* names[] = {"WFG1", "WFG2", "WFG3", "WFG4", "WFG5", "WFG6", "WFG7", "WFG8", "WFG9"};
+        return names[Variant - 1];
+    }
+
+private:
+    static constexpr size_t k = positionGenes;
+
+    enum class Reduction { WeightedSum, Sum, Nonseparable };
+
+    // Collapses position groups and the distance block into the M shape parameters
+    static std::vector<double> reduce(const std::vector<double>& y, Reduction reduction) {
+        std::vector<double> t(M);
+        auto block = [&](size_t first, size_t last, size_t out) {
+            std::vector<double> group(y.begin() + first, y.begin() + last);
+            if (reduction == Reduction::Nonseparable) {
+                t[out] = WfgTransforms::rNonsep(group, group.size());
+                return;
+            }
+            std::vector<double> weights(group.size(), 1.0);
+            if (reduction == Reduction::WeightedSum) {
+                for (size_t i = 0; i < group.size(); ++i) weights[i] = 2.0 * (first + i + 1);
+            }
+            t[out] = WfgTransforms::rSum(group, weights);
+        };
+        for (size_t m = 0; m + 1 < M; ++m) block(m * k / (M - 1), (m + 1) * k / (M - 1), m);
+        block(k, y.size(), M - 1);
+        return t;
+    }
+
+    static double shape(const std::vector<double>& x, size_t m) {
+        using benchmark_detail::pi;
+        double h = 1.0;
+        if constexpr (Variant == 1 || Variant == 2) {
+            if (m + 1 == M) {
+                if constexpr (Variant == 1) {
+                    return std::pow(1.0 - x[0] - std::cos(10.0 * pi * x[0] + pi / 2.0) / (10.0 * pi), 1.0);
+                } else {
+                    return 1.0 - x[0] * std::pow(std::cos(5.0 * x[0] * pi), 2);
+                }
+            }
+            for (size_t i = 0; i + 1 + m < M; ++i) h *= 1.0 - std::cos(x[i] * pi / 2.0);
+            if (m > 0) h *= 1.0 - std::sin(x[M - 1 - m] * pi / 2.0);
+        } else if constexpr (Variant == 3) {
+            for (size_t i = 0; i + 1 + m < M; ++i) h *= x[i];
+            if (m > 0) h *= 1.0 - x[M - 1 - m];
+        } else {
+            for (size_t i = 0; i + 1 + m < M; ++i) h *= std::sin(x[i] * pi / 2.0);
+            if (m > 0) h *= std::cos(x[M - 1 - m] * pi / 2.0);
+        }
+        return h;
+    }
+
+    static void objectivesFromShape(const std::vector<double>& x, double distance, std::vector<double>& f) {
+        f.resize(M);
+        for (size_t m = 0; m < M; ++m) f[m] = distance + 2.0 * (m + 1) * shape(x, m);
+    }
+
+public:
+    void evaluate(const GenomeType& genome, Objectives& objectives, std::mt19937&) const {
+        // z_i lies in [0, 2i]; dividing by 2i gives back the normalized gene
+        std::vector<double> y(genome.continuous.begin(), genome.continuous.end());
+        const size_t n = y.size();
+        const double paramA = 0.98 / 49.98;
+        std::vector<double> t;
+
+        if constexpr (Variant == 1) {
+            for (size_t i = k; i < n; ++i) y[i] = WfgTransforms::sLinear(y[i], 0.35);
+            for (size_t i = k; i < n; ++i) y[i] = WfgTransforms::bFlat(y[i], 0.8, 0.75, 0.85);
+            for (size_t i = 0; i < n; ++i) y[i] = WfgTransforms::bPoly(y[i], 0.02);
+            t = reduce(y, Reduction::WeightedSum);
+        } else if constexpr (Variant == 2 || Variant == 3) {
+            for (size_t i = k; i < n; ++i) y[i] = WfgTransforms::sLinear(y[i], 0.35);
+            std::vector<double> paired(y.begin(), y.begin() + k);
+            for (size_t i = k; i + 1 < n; i += 2) paired.push_back(WfgTransforms::rNonsep({y[i], y[i + 1]}, 2));
+            t = reduce(paired, Reduction::Sum);
+        } else if constexpr (Variant == 4) {
+            for (size_t i = 0; i < n; ++i) y[i] = WfgTransforms::sMulti(y[i], 30.0, 10.0, 0.35);
+            t = reduce(y, Reduction::Sum);
+        } else if constexpr (Variant == 5) {
+            for (size_t i = 0; i < n; ++i) y[i] = WfgTransforms::sDecept(y[i], 0.35, 0.001, 0.05);
+            t = reduce(y, Reduction::Sum);
+        } else if constexpr (Variant == 6) {
+            for (size_t i = k; i < n; ++i) y[i] = WfgTransforms::sLinear(y[i], 0.35);
+            t = reduce(y, Reduction::Nonseparable);
+        } else if constexpr (Variant == 7) {
+            std::vector<double> original = y;
+            for (size_t i = 0; i < k; ++i) {
+                std::vector<double> rest(original.begin() + i + 1, original.end());
+                y[i] = WfgTransforms::bParam(original[i], WfgTransforms::rSum(rest, std::vector<double>(rest.size(), 1.0)), paramA, 0.02, 50.0);
+            }
+            for (size_t i = k; i < n; ++i) y[i] = WfgTransforms::sLinear(y[i], 0.35);
+            t = reduce(y, Reduction::Sum);
+        } else if constexpr (Variant == 8) {
+            std::vector<double> original = y;
+            for (size_t i = k; i < n; ++i) {
+                std::vector<double> before(original.begin(), original.begin() + i);
+                y[i] = WfgTransforms::bParam(original[i], WfgTransforms::rSum(before, std::vector<double>(before.size(), 1.0)), paramA, 0.02, 50.0);
+            }
+            for (size_t i = k; i < n; ++i) y[i] = WfgTransforms::sLinear(y[i], 0.35);
+            t = reduce(y, Reduction::Sum);
+        } else {
+            std::vector<double> original = y;
+            for (size_t i = 0; i + 1 < n; ++i) {
+                std::vector<double> rest(original.begin() + i + 1, original.end());
+                y[i] = WfgTransforms::bParam(original[i], WfgTransforms::rSum(rest, std::vector<double>(rest.size(), 1.0)), paramA, 0.02, 50.0);
+            }
+            for (size_t i = 0; i < k; ++i) y[i] = WfgTransforms::sDecept(y[i], 0.35, 0.001, 0.05);
+            for (size_t i = k; i < n; ++i) y[i] = WfgTransforms::sMulti(y[i], 30.0, 95.0, 0.35);
+            t = reduce(y, Reduction::Nonseparable);
+        }
+
+        // Shape parameters; WFG3 degenerates every parameter but the first
+        std::vector<double> x(M - 1);
+        for (size_t i = 0; i + 1 < M; ++i) {
+            double a = (Variant == 3 && i > 0) ? 0.0 : 1.0;
+            x[i] = std::max(t[M - 1], a) * (t[i] - 0.5) + 0.5;
+        }
+        std::vector<double> f;
+        objectivesFromShape(x, t[M - 1], f);
+        std::copy(f.begin(), f.end(), objectives.begin());
+    }
+
+    static PointSet referenceFront(size_t samples) {
+        PointSet front;
+        if constexpr (Variant >= 4) {
+            // Concave fronts are the positive orthant of the ellipsoid sum (f_m / 2m)^2 = 1
+            front = benchmark_detail::sphereLattice(M, samples);
+            for (auto& point : front) {
+                for (size_t m = 0; m < M; ++m) point[m] *= 2.0 * (m + 1);
+            }
+            return front;
+        }
+        // Optimal distance parameters zero the distance term, so the front is the shape function itself
+        PointSet positions = Variant == 3 ? benchmark_detail::unitGrid(1, samples) : benchmark_detail::unitGrid(M - 1, samples);
+        for (const auto& position : positions) {
+            std::vector<double> x(M - 1, 0.5);
+            std::copy(position.begin(), position.end(), x.begin());
+            std::vector<double> f;
+            objectivesFromShape(x, 0.0, f);
+            front.push_back(f);
+        }
+        return nonDominatedFilter(front);
+    }
+};
+
+#endif // BENCHMARK_PROBLEMS_HPP
@@ -0,0 +1,199 @@
+#ifndef FEATURE_NORMALIZER_HPP
+#define FEATURE_NORMALIZER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Running mean and variance by Welford's update, numerically stable over any number of values
+struct RunningMoments {
+    uint64_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;  // Sum of squared deviations from the running mean
+
+    void add(double value) {
+        ++count;
+        double delta = value - mean;
+        mean += delta / count;
+        m2 += delta * (value - mean);
+    }
+
+    double variance() const { return count > 1 ? m2 / (count - 1) : 0.0; }
+    double deviation() const { return std::sqrt(variance()); }
+};
+
+// Streaming estimate of one quantile by the P-square algorithm (Jain and Chlamtac): five markers track the minimum,
+// the quantile, the maximum and two points between, and each value moves them by piecewise-parabolic interpolation.
+// Constant memory and update time, with no stored sample.
+class StreamingQuantile {
+private:
+    double quantile;
+    std::array<double, 5> heights{};
+    std::array<double, 5> positions{};  // Actual marker positions, one-based
+    std::array<double, 5> desired{};    // Where the markers should be
+    std::array<double, 5> increments{};
+    uint64_t count = 0;
+
+    double parabolic(size_t i, double sign) const {
+        return heights[i] + sign / (positions[i + 1] - positions[i - 1]) *
+               ((positions[i] - positions[i - 1] + sign) * (heights[i + 1] - heights[i]) / (positions[i + 1] - positions[i]) +
+                (positions[i + 1] - positions[i] - sign) * (heights[i] - heights[i - 1]) / (positions[i] - positions[i - 1]));
+    }
+
+public:
+    explicit StreamingQuantile(double quantile = 0.5) : quantile(quantile) {}
+
+    uint64_t size() const { return count; }
+
+    void add(double value) {
+        if (count < 5) {
+            heights[count++] = value;
+            if (count == 5) {
+                std::sort(heights.begin(), heights.end());
+                positions = {1.0, 2.0, 3.0, 4.0, 5.0};
+                desired = {1.0, 1.0 + 2.0 * quantile, 1.0 + 4.0 * quantile, 3.0 + 2.0 * quantile, 5.0};
+                increments = {0.0, quantile / 2.0, quantile, (1.0 + quantile) / 2.0, 1.0};
+            }
+            return;
+        }
+        size_t cell;
+        if (value < heights[0]) {
+            heights[0] = value;
+            cell = 0;
+        } else if (value >= heights[4]) {
+            heights[4] = value;
+            cell = 3;
+        } else {
+            cell = 0;
+            while (value >= heights[cell + 1]) ++cell;
+        }
+        for (size_t i = cell + 1; i < 5; ++i) positions[i] += 1.0;
+        for (size_t i = 0; i < 5; ++i) desired[i] += increments[i];
+        for (size_t i = 1; i < 4; ++i) {
+            double offset = desired[i] - positions[i];
+            if ((offset >= 1.0 && positions[i + 1] - positions[i] > 1.0) || (offset <= -1.0 && positions[i - 1] - positions[i] < -1.0)) {
+                double sign = offset > 0.0 ? 1.0 : -1.0;
+                double height = parabolic(i, sign);
+                if (heights[i - 1] < height && height < heights[i + 1]) {
+                    heights[i] = height;
+                } else {
+                    size_t neighbour = sign > 0.0 ? i + 1 : i - 1;
+                    heights[i] += sign * (heights[neighbour] - heights[i]) / (positions[neighbour] - positions[i]);
+                }
+                positions[i] += sign;
+            }
+        }
+        ++count;
+    }
+
+    // The estimate; exact while fewer than five values have arrived, and 0 before the first
+    double value() const {
+        if (count >= 5) return heights[2];
+        if (count == 0) return 0.0;
+        std::array<double, 5> sorted = heights;
+        std::sort(sorted.begin(), sorted.begin() + count);
+        return sorted[static_cast<size_t>(std::lround(quantile * (count - 1)))];
+    }
+};
+
+enum class FeatureScaling {
+    Fixed,     // Ranges chosen up front
+    Standard,  // Mean and standard deviation of the data
+    Robust     // Median and interquartile range of the data, unmoved by outliers
+};
+
+// Affine map into a space where features contribute comparably to Euclidean distance: (value - offset) * inverseScale
+// per feature. Multiplying by stored inverse scales keeps divisions out of every query.
+template<size_t Dimensions>
+struct FeatureTransform {
+    using Values = std::array<double, Dimensions>;
+
+    Values offset{};
+    Values inverseScale{};
+
+    static FeatureTransform ranges(const Values& scales) {
+        FeatureTransform transform;
+        for (size_t d = 0; d < Dimensions; ++d) transform.inverseScale[d] = 1.0 / scales[d];
+        return transform;
+    }
+
+    Values apply(const Values& values) const {
+        Values result;
+        for (size_t d = 0; d < Dimensions; ++d) result[d] = (values[d] - offset[d]) * inverseScale[d];
+        return result;
+    }
+
+    Values invert(const Values& normalized) const {
+        Values result;
+        for (size_t d = 0; d < Dimensions; ++d) result[d] = normalized[d] / inverseScale[d] + offset[d];
+        return result;
+    }
+
+    // Whether any feature's scale differs from other's by more than the relative tolerance. Offsets are ignored:
+    // translating every point leaves distances unchanged.
+    bool scalesDiffer(const FeatureTransform& other, double tolerance) const {
+        for (size_t d = 0; d < Dimensions; ++d) {
+            if (std::abs(inverseScale[d] / other.inverseScale[d] - 1.0) > tolerance) return true;
+        }
+        return false;
+    }
+};
+
+// Per-feature statistics of a stream of points, from which a normalization is learned: Welford moments for Standard
+// scaling and streaming quartiles for Robust scaling. O(1) memory and update per feature.
+template<size_t Dimensions>
+class FeatureNormalizer {
+public:
+    using Values = std::array<double, Dimensions>;
+    using Transform = FeatureTransform<Dimensions>;
+
+    static constexpr uint64_t minimumCount = 64;  // Points before any statistic replaces the fallback
+
+private:
+    std::array<RunningMoments, Dimensions> moments;
+    std::array<StreamingQuantile, Dimensions> lower;
+    std::array<StreamingQuantile, Dimensions> median;
+    std::array<StreamingQuantile, Dimensions> upper;
+
+public:
+    FeatureNormalizer() {
+        lower.fill(StreamingQuantile(0.25));
+        median.fill(StreamingQuantile(0.5));
+        upper.fill(StreamingQuantile(0.75));
+    }
+
+    uint64_t count() const { return moments[0].count; }
+
+    void add(const Values& values) {
+        for (size_t d = 0; d < Dimensions; ++d) {
+            moments[d].add(values[d]);
+            lower[d].add(values[d]);
+            median[d].add(values[d]);
+            upper[d].add(values[d]);
+        }
+    }
+
+    // The learned normalization. A feature keeps fallback's offset and scale until minimumCount points have arrived
+    // or while its spread is zero; Robust falls back to the standard deviation for a feature whose quartiles coincide.
+    Transform transform(FeatureScaling scaling, const Transform& fallback) const {
+        if (scaling == FeatureScaling::Fixed || count() < minimumCount) return fallback;
+        Transform result = fallback;
+        for (size_t d = 0; d < Dimensions; ++d) {
+            double center = moments[d].mean;
+            double spread = moments[d].deviation();
+            if (scaling == FeatureScaling::Robust) {
+                double range = upper[d].value() - lower[d].value();
+                center = median[d].value();
+                if (range > 0.0) spread = range / 1.349;  // The interquartile range of a normal distribution in sigmas
+            }
+            if (!(spread > 0.0) || !std::isfinite(spread)) continue;
+            result.offset[d] = center;
+            result.inverseScale[d] = 1.0 / spread;
+        }
+        return result;
+    }
+};
+
+#endif // FEATURE_NORMALIZER_HPP
@@ -0,0 +1,246 @@
+#ifndef GDE3_ENGINE_HPP
+#define GDE3_ENGINE_HPP
+
+#include "InitialDesign.hpp"
+#include "MogaProblem.hpp"
+#include "OptimizationSettings.hpp"
+#include "ParallelEvaluator.hpp"
+#include "ParetoArchive.hpp"
+#include "ParetoRanking.hpp"
+#include "Telemetry.hpp"
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Generalized differential evolution (GDE3, Kukkonen and Lampinen): DE/rand/1/bin trial vectors with a
+// dominance-based replacement rule, truncated by non-dominated sorting and crowding like NSGA-II
+template<MogaProblem Problem>
+class Gde3Engine {
+public:
+    static constexpr std::size_t objectiveCount = Problem::objectiveCount;
+    static constexpr std::size_t continuousGenes = Problem::continuousGenes;
+    static constexpr std::size_t categoricalGenes = Problem::categoricalGenes;
+
+    using GenomeType = Genome<continuousGenes, categoricalGenes>;
+    using Objectives = std::array<double, objectiveCount>;
+    using MessageSink = std::function<void(EngineMessage, const std::string&)>;
+
+    struct Individual {
+        GenomeType genome;
+        Objectives objectives{};
+        int rank = 0;
+        double crowdingDistance = 0.0;
+    };
+    using Population = std::vector<Individual>;
+    using GenerationObserver = std::function<void(int generation, const Population& population)>; // Generation 0 is the initial population
+
+private:
+    using Evaluator = ParallelEvaluator<Problem>;
+
+    std::unique_ptr<Evaluator> ownedEvaluator;
+    Evaluator* evaluator;   // ownedEvaluator, or one shared with other engines
+    ParetoArchive<Problem>* archive;
+    int archiveSource;
+    OptimizationSettings settings;
+    std::mt19937 rng;
+    std::vector<GenomeType> seedGenomes;
+    MessageSink messageSink;
+    GenerationObserver generationObserver;
+    SearchControl control;
+    int completedGenerations;
+    TelemetryRecorder<objectiveCount> telemetry;
+
+    void report(EngineMessage kind, const std::string& message) const;
+    bool evaluateBatch(Population& individuals);
+    Individual makeTrial(const Population& population, size_t target);
+    Population selectSurvivors(Population& combined, size_t populationSize) const;
+
+    Gde3Engine(std::unique_ptr<Evaluator> owned, Evaluator* shared, const OptimizationSettings& settings, unsigned int seed)
+        : ownedEvaluator(std::move(owned)), evaluator(ownedEvaluator ? ownedEvaluator.get() : shared), archive(nullptr),
+          archiveSource(0), settings(settings), rng(seed), completedGenerations(0) {}
+
+public:
+    Gde3Engine(const Problem& problem, const OptimizationSettings& settings, unsigned int seed)
+        : Gde3Engine(std::make_unique<Evaluator>(problem, settings.workerThreads, settings.evaluationCacheCapacity), nullptr, settings, seed) {}
+    // Shares the evaluation backend (pool, cache, evaluation count) with other engines
+    Gde3Engine(Evaluator& evaluator, const OptimizationSettings& settings, unsigned int seed)
+        : Gde3Engine(nullptr, &evaluator, settings, seed) {}
+
+    Gde3Engine(const Gde3Engine&) = delete;
+    Gde3Engine& operator=(const Gde3Engine&) = delete;
+
+    void setSeedGenomes(const std::vector<GenomeType>& genomes) { seedGenomes = genomes; }
+    void setMessageSink(MessageSink sink) { messageSink = std::move(sink); }
+    void setGenerationObserver(GenerationObserver observer) { generationObserver = std::move(observer); }
+    void setControl(const SearchControl& stopControl) { control = stopControl; }
+    void setTelemetrySink(TelemetrySink<objectiveCount> sink) { telemetry.setSink(std::move(sink)); }
+    // Every evaluated individual is offered to the archive, tagged with source
+    void setArchive(ParetoArchive<Problem>* target, int source) {
+        archive = target;
+        archiveSource = source;
+    }
+
+    Population run(int populationSize, int generations);
+
+    size_t evaluationCount() const { return evaluator->evaluationCount(); }
+    int generationsCompleted() const { return completedGenerations; } // Below the requested count when stopped early
+};
+
+template<MogaProblem Problem>
+void Gde3Engine<Problem>::report(EngineMessage kind, const std::string& message) const {
+    if (messageSink) messageSink(kind, message);
+}
+
+template<MogaProblem Problem>
+bool Gde3Engine<Problem>::evaluateBatch(Population& individuals) {
+    bool complete = evaluator->evaluateBatch(individuals, rng, control);
+    if (archive) archive->insertAll(individuals, archiveSource);
+    return complete;
+}
+
+template<MogaProblem Problem>
+typename Gde3Engine<Problem>::Individual Gde3Engine<Problem>::makeTrial(const Population& population, size_t target) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::uniform_int_distribution<size_t> pick(0, population.size() - 1);
+    size_t r1, r2, r3;
+    do { r1 = pick(rng); } while (r1 == target);
+    do { r2 = pick(rng); } while (r2 == target || r2 == r1);
+    do { r3 = pick(rng); } while (r3 == target || r3 == r1 || r3 == r2);
+    const GenomeType& base = population[r1].genome;
+    const GenomeType& first = population[r2].genome;
+    const GenomeType& second = population[r3].genome;
+    const GenomeType& parent = population[target].genome;
+    double weight = settings.differentialWeight;
+    double crossoverRate = settings.differentialCrossover;
+
+    // One gene always comes from the mutant so the trial never duplicates its parent
+    std::uniform_int_distribution<size_t> forcedDist(0, continuousGenes + categoricalGenes - 1);
+    size_t forced = forcedDist(rng);
+
+    Individual trial;
+    trial.genome = parent;
+    for (size_t i = 0; i < continuousGenes; ++i) {
+        if (dist(rng) >= crossoverRate && i != forced) continue;
+        double value = base.continuous[i] + weight * (first.continuous[i] - second.continuous[i]);
+        // Out-of-range genes land between the parent and the violated bound
+        if (value < 0.0) value = parent.continuous[i] * dist(rng);
+        else if (value > 1.0) value = parent.continuous[i] + dist(rng) * (1.0 - parent.continuous[i]);
+        trial.genome.continuous[i] = value;
+    }
+
+    // Options have no difference vector: take the base option, or a random one with probability F where the differentials disagree
+    for (size_t i = 0; i < categoricalGenes; ++i) {
+        if (dist(rng) >= crossoverRate && continuousGenes + i != forced) continue;
+        int option = base.categorical[i];
+        if (first.categorical[i] != second.categorical[i] && dist(rng) < weight) {
+            option = std::min(Problem::categoryCounts[i] - 1, static_cast<int>(dist(rng) * Problem::categoryCounts[i]));
+        }
+        trial.genome.categorical[i] = option;
+    }
+    return trial;
+}
+
+template<MogaProblem Problem>
+typename Gde3Engine<Problem>::Population Gde3Engine<Problem>::selectSurvivors(Population& combined, size_t populationSize) const {
+    std::vector<Objectives> objectives;
+    objectives.reserve(combined.size());
+    for (const auto& ind : combined) objectives.push_back(ind.objectives);
+    Fronts fronts = sortNonDominated(objectives);
+
+    Population next;
+    next.reserve(populationSize);
+    for (size_t f = 0; f < fronts.size() && next.size() < populationSize; ++f) {
+        std::vector<double> crowding = crowdingDistances(objectives, fronts[f]);
+        std::vector<size_t> order(fronts[f].size());
+        for (size_t k = 0; k < order.size(); ++k) order[k] = k;
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return crowding[a] > crowding[b]; });
+        for (size_t k : order) {
+            if (next.size() >= populationSize) break;
+            Individual ind = combined[fronts[f][k]];
+            ind.rank = static_cast<int>(f) + 1;
+            ind.crowdingDistance = crowding[k];
+            next.push_back(ind);
+        }
+    }
+    return next;
+}
+
+template<MogaProblem Problem>
+typename Gde3Engine<Problem>::Population Gde3Engine<Problem>::run(int populationSize, int generations) {
+    if (populationSize < 4 || generations < 0) {
+        throw std::invalid_argument("GDE3 needs a population of at least 4 and non-negative generations");
+    }
+
+    auto reportStop = [&](int completed) {
+        report(EngineMessage::Progress, "Stopping early after " + std::to_string(completed) + "/" + std::to_string(generations) + " generations");
+    };
+
+    report(EngineMessage::Progress, "Initializing GDE3 population...");
+    telemetry.begin();
+    Population population(populationSize);
+    std::vector<GenomeType> initialGenomes = generateInitialGenomes<Problem>(population.size(), seedGenomes, settings, rng);
+    for (size_t i = 0; i < population.size(); ++i) population[i].genome = initialGenomes[i];
+    telemetry.lap(&GenerationTelemetry<objectiveCount>::variationSeconds);
+    bool initialComplete = evaluateBatch(population);
+    telemetry.lap(&GenerationTelemetry<objectiveCount>::evaluationSeconds);
+    population = selectSurvivors(population, population.size());
+    if (!initialComplete) {
+        reportStop(0);
+        return population;
+    }
+    telemetry.lap(&GenerationTelemetry<objectiveCount>::rankingSeconds);
+    telemetry.publish(0, population, evaluationCount());
+    if (generationObserver) generationObserver(0, population);
+
+    for (int gen = 0; gen < generations; ++gen) {
+        if (control.stopRequested()) {
+            reportStop(gen);
+            break;
+        }
+        telemetry.begin();
+        Population trials;
+        trials.reserve(population.size());
+        for (size_t i = 0; i < population.size(); ++i) trials.push_back(makeTrial(population, i));
+        telemetry.lap(&GenerationTelemetry<objectiveCount>::variationSeconds);
+        bool trialsComplete = evaluateBatch(trials);
+        telemetry.lap(&GenerationTelemetry<objectiveCount>::evaluationSeconds);
+        if (!trialsComplete) {
+            // Trials no longer line up with their parents; the evaluated ones have already reached the archive
+            reportStop(gen);
+            return population;
+        }
+
+        // A trial replaces a parent it weakly dominates, is dropped if the parent dominates it, and otherwise joins it
+        Population combined;
+        combined.reserve(2 * population.size());
+        for (size_t i = 0; i < population.size(); ++i) {
+            const Objectives& parent = population[i].objectives;
+            const Objectives& trial = trials[i].objectives;
+            bool weaklyDominates = true;
+            for (size_t objIdx = 0; objIdx < objectiveCount; ++objIdx) weaklyDominates = weaklyDominates && trial[objIdx] <= parent[objIdx];
+            if (weaklyDominates) {
+                combined.push_back(trials[i]);
+            } else if (dominatesObjectives(parent, trial)) {
+                combined.push_back(population[i]);
+            } else {
+                combined.push_back(population[i]);
+                combined.push_back(trials[i]);
+            }
+        }
+
+        // Ranking and truncation happen together, so the whole step counts as selection
+        population = selectSurvivors(combined, static_cast<size_t>(populationSize));
+        telemetry.lap(&GenerationTelemetry<objectiveCount>::selectionSeconds);
+        telemetry.publish(gen + 1, population, evaluationCount());
+        if (generationObserver) generationObserver(gen + 1, population);
+        completedGenerations = gen + 1;
+    }
+    return population;
+}
+
+#endif // GDE3_ENGINE_HPP
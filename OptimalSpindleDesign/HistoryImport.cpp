@@ -0,0 +1,168 @@
+#include "HistoryImport.hpp"
+#include "MappedFile.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+struct ChunkResult {
+    std::vector<MaintenanceRecord> records;
+    uint64_t lines = 0;      // Line breaks in the chunk, to number the lines of the next one
+    uint64_t rejected = 0;
+    std::vector<HistoryImportError> errors;  // Lines relative to the chunk's first line
+};
+
+std::string_view trim(std::string_view text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) return {};
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+// fieldOfColumn[c] is the ImportField stored in column c, or -1
+std::vector<int> mapColumns(std::string_view header, const HistoryImportOptions& options) {
+    std::vector<int> fieldOfColumn;
+    if (options.hasHeader) {
+        std::vector<std::string_view> names;
+        size_t start = 0;
+        while (true) {
+            size_t end = header.find(options.delimiter, start);
+            names.push_back(trim(header.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start)));
+            if (end == std::string_view::npos) break;
+            start = end + 1;
+        }
+        fieldOfColumn.assign(names.size(), -1);
+        for (size_t field = 0; field < importFieldCount; ++field) {
+            auto match = std::find(names.begin(), names.end(), options.columnNames[field]);
+            if (match == names.end()) throw std::invalid_argument("Column not found in header: " + options.columnNames[field]);
+            fieldOfColumn[match - names.begin()] = static_cast<int>(field);
+        }
+    } else {
+        for (size_t field = 0; field < importFieldCount; ++field) {
+            int column = options.columnIndices[field];
+            if (column < 0) throw std::invalid_argument("Column indices must not be negative");
+            if (static_cast<size_t>(column) >= fieldOfColumn.size()) fieldOfColumn.resize(column + 1, -1);
+            fieldOfColumn[column] = static_cast<int>(field);
+        }
+    }
+    return fieldOfColumn;
+}
+
+// Parses one row into values; returns an empty string on success and the reason for rejecting it otherwise
+std::string parseRow(std::string_view row, const std::vector<int>& fieldOfColumn, char delimiter,
+                     std::array<double, importFieldCount>& values) {
+    size_t column = 0;
+    size_t parsed = 0;
+    size_t start = 0;
+    while (column < fieldOfColumn.size()) {
+        size_t end = row.find(delimiter, start);
+        int field = fieldOfColumn[column];
+        if (field >= 0) {
+            std::string_view text = trim(row.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start));
+            double value;
+            auto [next, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (text.empty() || error != std::errc() || next != text.data() + text.size() || !std::isfinite(value)) {
+                return "column " + std::to_string(column + 1) + " is not a number";
+            }
+            values[field] = value;
+            ++parsed;
+        }
+        ++column;
+        if (end == std::string_view::npos) break;
+        start = end + 1;
+    }
+    if (parsed < importFieldCount) return "expected at least " + std::to_string(fieldOfColumn.size()) + " columns";
+    double label = values[static_cast<size_t>(ImportField::Label)];
+    if (label != 0.0 && label != 1.0) return "label must be 0 or 1";
+    return {};
+}
+
+ChunkResult parseChunk(std::string_view chunk, const std::vector<int>& fieldOfColumn, const HistoryImportOptions& options) {
+    ChunkResult result;
+    result.records.reserve(chunk.size() / 48);  // A typical row is a little longer than that
+    std::array<double, importFieldCount> values;
+    size_t start = 0;
+    while (start < chunk.size()) {
+        size_t end = chunk.find('\n', start);
+        if (end == std::string_view::npos) end = chunk.size();
+        std::string_view row = chunk.substr(start, end - start);
+        if (!trim(row).empty()) {
+            std::string reason = parseRow(row, fieldOfColumn, options.delimiter, values);
+            if (reason.empty()) {
+                result.records.emplace_back(values[0], values[1], values[2], values[3], values[4], values[5], static_cast<int>(values[6]));
+            } else {
+                if (result.errors.size() < options.maxReportedErrors) result.errors.push_back({result.lines, std::move(reason)});
+                ++result.rejected;
+            }
+        }
+        if (end < chunk.size()) ++result.lines;
+        start = end + 1;
+    }
+    return result;
+}
+} // namespace
+
+HistoryImportReport importMaintenanceCsv(const std::string& path, MaintenanceHistory& history, const HistoryImportOptions& options) {
+    auto started = std::chrono::steady_clock::now();
+    MappedFile file(path);
+    std::string_view text(reinterpret_cast<const char*>(file.data()), file.size());
+    if (text.substr(0, 3) == "\xEF\xBB\xBF") text.remove_prefix(3);  // UTF-8 byte order mark
+
+    uint64_t firstLine = 1;
+    std::string_view header;
+    if (options.hasHeader) {
+        size_t end = std::min(text.find('\n'), text.size());
+        header = text.substr(0, end);
+        text.remove_prefix(std::min(end + 1, text.size()));
+        firstLine = 2;
+    }
+    std::vector<int> fieldOfColumn = mapColumns(header, options);
+
+    // Chunk boundaries fall just after a line break, so no row spans two chunks
+    std::vector<std::string_view> chunks;
+    size_t chunkBytes = std::max<size_t>(options.chunkBytes, 1);
+    while (!text.empty()) {
+        size_t end = text.size() <= chunkBytes ? text.size() : std::min(text.find('\n', chunkBytes), text.size() - 1) + 1;
+        chunks.push_back(text.substr(0, end));
+        text.remove_prefix(end);
+    }
+
+    HistoryImportReport report;
+    report.bytes = file.size();
+    ThreadPool& executor = ThreadPool::shared();
+    size_t window = 2 * executor.size() + 1;  // Chunks parsed ahead of the appends
+    std::deque<std::future<ChunkResult>> pending;
+    size_t submitted = 0;
+    uint64_t line = firstLine;
+    try {
+        while (submitted < chunks.size() || !pending.empty()) {
+            while (submitted < chunks.size() && pending.size() < window) {
+                std::string_view chunk = chunks[submitted++];
+                pending.push_back(executor.submit([chunk, &fieldOfColumn, &options]() { return parseChunk(chunk, fieldOfColumn, options); }));
+            }
+            ChunkResult result = executor.wait(pending.front());
+            pending.pop_front();
+            history.appendAll(result.records);
+            report.rowsImported += result.records.size();
+            report.rowsRejected += result.rejected;
+            for (HistoryImportError& error : result.errors) {
+                if (report.errors.size() == options.maxReportedErrors) break;
+                report.errors.push_back({line + error.line, std::move(error.reason)});
+            }
+            line += result.lines;
+        }
+    } catch (...) {
+        // Parse tasks still in flight read the mapping and the column map, so they must finish first
+        for (auto& result : pending) result.wait();
+        throw;
+    }
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return report;
+}
@@ -0,0 +1,48 @@
+#ifndef HISTORY_IMPORT_HPP
+#define HISTORY_IMPORT_HPP
+
+#include "MaintenanceHistory.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Fields of a maintenance record, in MaintenanceRecord order
+enum class ImportField { Vibration, Temperature, Load, BearingLife, SpindleLife, WheelWear, Label };
+inline constexpr size_t importFieldCount = 7;
+
+struct HistoryImportOptions {
+    char delimiter = ',';
+    bool hasHeader = true;
+    // Header name of each field, in ImportField order; used when hasHeader is set
+    std::array<std::string, importFieldCount> columnNames = {"vibration", "temperature", "load", "bearing_life", "spindle_life",
+                                                             "wheel_wear", "label"};
+    // Zero-based column of each field, in ImportField order; used without a header
+    std::array<int, importFieldCount> columnIndices = {0, 1, 2, 3, 4, 5, 6};
+    size_t chunkBytes = size_t(4) << 20;  // Parse task size; chunks end on a line break
+    size_t maxReportedErrors = 100;       // Rejected rows beyond this are counted but not described
+};
+
+struct HistoryImportError {
+    uint64_t line;  // One-based line of the file
+    std::string reason;
+};
+
+struct HistoryImportReport {
+    uint64_t rowsImported = 0;
+    uint64_t rowsRejected = 0;
+    uint64_t bytes = 0;
+    double seconds = 0.0;
+    std::vector<HistoryImportError> errors;  // The first maxReportedErrors rejections, in file order
+};
+
+// Bulk-loads a CSV or sensor log into history. The file is memory-mapped and cut into chunks at line breaks; the
+// chunks are parsed in parallel on the shared executor with std::from_chars and appended in file order, a few chunks
+// ahead of the appends so memory stays bounded. Fields are unquoted; blank lines are skipped. A row is rejected when
+// a mapped field is missing, is not a finite number, or the label is not 0 or 1. Throws std::runtime_error if the
+// file cannot be read and std::invalid_argument if a named column is missing from the header.
+HistoryImportReport importMaintenanceCsv(const std::string& path, MaintenanceHistory& history,
+                                         const HistoryImportOptions& options = HistoryImportOptions());
+
+#endif // HISTORY_IMPORT_HPP
@@ -0,0 +1,594 @@
+#include "HistoryStore.hpp"
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr size_t dimensions = HistoryStore::dimensions;
+using Features = HistoryStore::Features;
+using StoredPoint = HistoryStore::StoredPoint;
+
+constexpr char baseMagic[8] = {'S', 'P', 'N', 'D', 'B', 'A', 'S', 'E'};
+constexpr char segmentMagic[8] = {'S', 'P', 'N', 'D', 'S', 'E', 'G', 'M'};
+constexpr uint32_t byteOrderMark = 0x01020304;  // Files are native-endian; a foreign one fails this check
+constexpr size_t sectionAlignment = 64;
+constexpr size_t leafSize = 32;
+
+struct BaseHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t dimensions;
+    uint32_t byteOrder;
+    uint32_t reserved;
+    uint64_t recordCount;
+    uint64_t nodeCount;
+    uint64_t nextSegment;    // First write-ahead segment not folded into this base
+    uint64_t nodesOffset;
+    uint64_t columnsOffset;  // Column d starts at columnsOffset + d * columnStride
+    uint64_t columnStride;   // Bytes per column, with at least one distance group of padding past the last record
+    uint64_t labelsOffset;
+    uint64_t fileSize;
+};
+
+// Node 0 is the root; a leaf covers positions begin..end of the columns
+struct BaseNode {
+    float lower[dimensions];
+    float upper[dimensions];
+    int32_t left;   // -1 for a leaf
+    int32_t right;
+    uint32_t axis;
+    float split;
+    uint32_t begin;
+    uint32_t end;
+};
+
+struct SegmentHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t dimensions;
+    uint32_t byteOrder;
+    uint32_t reserved;
+};
+
+struct SegmentRecord {
+    float features[dimensions];
+    int32_t label;
+    uint32_t checksum;  // Over the fields above; a torn or garbled record ends the segment
+};
+
+static_assert(sizeof(BaseNode) == 72 && sizeof(SegmentRecord) == 32, "On-disk layouts must not depend on padding");
+
+uint64_t alignUp(uint64_t offset) { return (offset + sectionAlignment - 1) / sectionAlignment * sectionAlignment; }
+
+// FNV-1a
+uint32_t checksum(const SegmentRecord& record) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&record);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(SegmentRecord, checksum); ++i) hash = (hash ^ bytes[i]) * 16777619u;
+    return hash;
+}
+
+HistoryStore::Point toPoint(const Features& features) {
+    HistoryStore::Point point;
+    for (size_t d = 0; d < dimensions; ++d) point[d] = features[d];
+    return point;
+}
+
+bool syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+// Makes a rename within directory durable; Windows has no equivalent and needs none
+void syncDirectory(const std::string& directory) {
+#ifndef _WIN32
+    int descriptor = open(directory.c_str(), O_RDONLY);
+    if (descriptor < 0) return;
+    fsync(descriptor);
+    close(descriptor);
+#endif
+}
+
+// Parses names of the form prefix<number>suffix
+bool numberedName(const std::string& name, const std::string& prefix, const std::string& suffix, uint64_t& number) {
+    if (name.size() <= prefix.size() + suffix.size() || name.compare(0, prefix.size(), prefix) != 0 ||
+        name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+        return false;
+    }
+    std::string digits = name.substr(prefix.size(), name.size() - prefix.size() - suffix.size());
+    if (digits.find_first_not_of("0123456789") != std::string::npos) return false;
+    number = std::stoull(digits);
+    return true;
+}
+
+float boxDistance(const Features& query, const BaseNode& node) {
+    float sum = 0.0f;
+    for (size_t d = 0; d < dimensions; ++d) {
+        float gap = std::max({node.lower[d] - query[d], query[d] - node.upper[d], 0.0f});
+        sum += gap * gap;
+    }
+    return sum;
+}
+
+// Builds the subtree over points[begin, end), reordering them into leaf order, and returns its node index. Splits
+// at the median of the widest dimension with the same partitionAtMedian as KnnIndex::rebuild.
+int32_t buildNode(std::vector<StoredPoint>& points, uint32_t begin, uint32_t end, std::vector<BaseNode>& nodes) {
+    int32_t index = static_cast<int32_t>(nodes.size());
+    nodes.emplace_back();
+    BaseNode node{};
+    std::fill(std::begin(node.lower), std::end(node.lower), std::numeric_limits<float>::infinity());
+    std::fill(std::begin(node.upper), std::end(node.upper), -std::numeric_limits<float>::infinity());
+    for (uint32_t i = begin; i < end; ++i) {
+        for (size_t d = 0; d < dimensions; ++d) {
+            node.lower[d] = std::min(node.lower[d], points[i].features[d]);
+            node.upper[d] = std::max(node.upper[d], points[i].features[d]);
+        }
+    }
+    node.left = -1;
+    node.right = -1;
+    node.begin = begin;
+    node.end = end;
+    if (end - begin > leafSize) {
+        uint32_t axis = 0;
+        for (uint32_t d = 1; d < dimensions; ++d) {
+            if (node.upper[d] - node.lower[d] > node.upper[axis] - node.lower[axis]) axis = d;
+        }
+        auto first = points.begin() + begin;
+        auto last = points.begin() + end;
+        float splitValue = 0.0f;
+        auto boundary = partitionAtMedian(first, last, [axis](const StoredPoint& point) { return point.features[axis]; }, splitValue);
+        // Only points with no extent along the widest axis coincide and stay one leaf
+        if (boundary != last) {
+            uint32_t split = static_cast<uint32_t>(boundary - points.begin());
+            node.axis = axis;
+            node.split = splitValue;
+            node.left = buildNode(points, begin, split, nodes);
+            node.right = buildNode(points, split, end, nodes);
+        }
+    }
+    nodes[index] = node;
+    return index;
+}
+
+// Writes bytes at offset of a file written front to back, zero-filling the gap since position
+void writeAt(std::FILE* file, uint64_t& position, uint64_t offset, const void* data, size_t bytes, const std::string& path) {
+    static const char zeros[sectionAlignment] = {};
+    while (position < offset) {
+        size_t gap = static_cast<size_t>(std::min<uint64_t>(offset - position, sizeof(zeros)));
+        if (std::fwrite(zeros, 1, gap, file) != gap) throw std::runtime_error("Cannot write history file: " + path);
+        position += gap;
+    }
+    if (bytes > 0 && std::fwrite(data, 1, bytes, file) != bytes) throw std::runtime_error("Cannot write history file: " + path);
+    position += bytes;
+}
+
+void writeBase(const std::string& path, const std::vector<StoredPoint>& points, const std::vector<BaseNode>& nodes,
+               uint64_t nextSegment) {
+    BaseHeader header{};
+    std::memcpy(header.magic, baseMagic, sizeof(baseMagic));
+    header.version = HistoryStore::formatVersion;
+    header.dimensions = static_cast<uint32_t>(dimensions);
+    header.byteOrder = byteOrderMark;
+    header.recordCount = points.size();
+    header.nodeCount = nodes.size();
+    header.nextSegment = nextSegment;
+    header.nodesOffset = alignUp(sizeof(BaseHeader));
+    header.columnsOffset = alignUp(header.nodesOffset + nodes.size() * sizeof(BaseNode));
+    header.columnStride = alignUp((points.size() + knnGroupWidth) * sizeof(float));
+    header.labelsOffset = header.columnsOffset + dimensions * header.columnStride;
+    header.fileSize = alignUp(header.labelsOffset + points.size() * sizeof(int32_t));
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) throw std::runtime_error("Cannot create history file: " + path);
+    try {
+        uint64_t position = 0;
+        writeAt(file, position, 0, &header, sizeof(header), path);
+        writeAt(file, position, header.nodesOffset, nodes.data(), nodes.size() * sizeof(BaseNode), path);
+        std::vector<float> column(points.size());
+        for (size_t d = 0; d < dimensions; ++d) {
+            for (size_t i = 0; i < points.size(); ++i) column[i] = points[i].features[d];
+            writeAt(file, position, header.columnsOffset + d * header.columnStride, column.data(), column.size() * sizeof(float), path);
+        }
+        std::vector<int32_t> labels(points.size());
+        for (size_t i = 0; i < points.size(); ++i) labels[i] = points[i].label;
+        writeAt(file, position, header.labelsOffset, labels.data(), labels.size() * sizeof(int32_t), path);
+        writeAt(file, position, header.fileSize, nullptr, 0, path);
+        if (!syncFile(file)) throw std::runtime_error("Cannot write history file: " + path);
+    } catch (...) {
+        std::fclose(file);
+        throw;
+    }
+    if (std::fclose(file) != 0) throw std::runtime_error("Cannot write history file: " + path);
+}
+} // namespace
+
+// A mapped, validated base file. Only the header and section bounds are checked on open, so opening stays
+// constant-time; the sections are trusted as written.
+class HistoryStore::BaseFile {
+private:
+    MappedFile file;
+    const BaseHeader* header = nullptr;
+    const BaseNode* nodes = nullptr;
+    std::array<const float*, dimensions> columns{};
+    const int32_t* labels = nullptr;
+
+    FeatureColumns<dimensions> leaf(const BaseNode& node) const {
+        FeatureColumns<dimensions> view;
+        for (size_t d = 0; d < dimensions; ++d) view.columns[d] = columns[d] + node.begin;
+        view.labels = labels + node.begin;
+        view.size = node.end - node.begin;
+        view.firstId = node.begin;
+        return view;
+    }
+
+public:
+    explicit BaseFile(const std::string& path) : file(path) {
+        const unsigned char* bytes = file.data();
+        uint64_t size = file.size();
+        if (size < sizeof(BaseHeader)) throw std::runtime_error("Truncated history file: " + path);
+        header = reinterpret_cast<const BaseHeader*>(bytes);
+        if (std::memcmp(header->magic, baseMagic, sizeof(baseMagic)) != 0 || header->byteOrder != byteOrderMark) {
+            throw std::runtime_error("Not a history file: " + path);
+        }
+        if (header->version != formatVersion || header->dimensions != dimensions) {
+            throw std::runtime_error("Unsupported history file version: " + path);
+        }
+        uint64_t count = header->recordCount;
+        bool consistent = header->fileSize == size && count > 0 && count <= std::numeric_limits<uint32_t>::max() &&
+                          header->nodeCount > 0 && header->nodesOffset % sectionAlignment == 0 &&
+                          header->columnsOffset % sectionAlignment == 0 && header->columnStride % sectionAlignment == 0 &&
+                          header->labelsOffset % sectionAlignment == 0 &&
+                          header->nodesOffset + header->nodeCount * sizeof(BaseNode) <= header->columnsOffset &&
+                          header->columnStride >= (count + knnGroupWidth) * sizeof(float) &&
+                          header->columnsOffset + dimensions * header->columnStride <= header->labelsOffset &&
+                          header->labelsOffset + count * sizeof(int32_t) <= size;
+        if (!consistent) throw std::runtime_error("Corrupt history file: " + path);
+        nodes = reinterpret_cast<const BaseNode*>(bytes + header->nodesOffset);
+        for (size_t d = 0; d < dimensions; ++d) {
+            columns[d] = reinterpret_cast<const float*>(bytes + header->columnsOffset + d * header->columnStride);
+        }
+        labels = reinterpret_cast<const int32_t*>(bytes + header->labelsOffset);
+    }
+
+    size_t size() const { return static_cast<size_t>(header->recordCount); }
+    uint64_t nextSegment() const { return header->nextSegment; }
+
+    StoredPoint point(size_t position) const {
+        StoredPoint stored;
+        for (size_t d = 0; d < dimensions; ++d) stored.features[d] = columns[d][position];
+        stored.label = labels[position];
+        return stored;
+    }
+
+    int32_t homeLeaf(const Features& query) const {
+        int32_t nodeIndex = 0;
+        while (nodes[nodeIndex].left >= 0) {
+            const BaseNode& node = nodes[nodeIndex];
+            nodeIndex = query[node.axis] < node.split ? node.left : node.right;
+        }
+        return nodeIndex;
+    }
+
+    void search(int32_t nodeIndex, const Features& query, size_t k, KnnNeighbor* best, size_t& found) const {
+        const BaseNode& node = nodes[nodeIndex];
+        if (node.left < 0) {
+            leaf(node).nearest(query, k, best, found);
+            return;
+        }
+        int32_t first = node.left;
+        int32_t second = node.right;
+        if (query[node.axis] >= node.split) std::swap(first, second);
+        for (int32_t child : {first, second}) {
+            if (found == k && boxDistance(query, nodes[child]) > best[k - 1].distance) continue;
+            search(child, query, k, best, found);
+        }
+    }
+};
+
+void HistoryStore::Tail::add(const StoredPoint& point) {
+    index.insert(static_cast<uint32_t>(points.size()), toPoint(point.features), point.label);
+    points.push_back(point);
+}
+
+void HistoryStore::Tail::addAll(std::span<const StoredPoint> batch) {
+    std::vector<Point> coordinates(batch.size());
+    std::vector<int> labels(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        coordinates[i] = toPoint(batch[i].features);
+        labels[i] = batch[i].label;
+    }
+    index.insertBatch(static_cast<uint32_t>(points.size()), coordinates, labels);
+    points.insert(points.end(), batch.begin(), batch.end());
+}
+
+void HistoryStore::Tail::clear() {
+    points.clear();
+    index.clear();
+}
+
+HistoryStore::HistoryStore(const std::string& directory, size_t compactThreshold)
+    : directory(directory), compactThreshold(std::max<size_t>(1, compactThreshold)) {
+    std::filesystem::create_directories(directory);
+    std::vector<uint64_t> baseNumbers;
+    std::vector<uint64_t> segmentNumbers;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        std::string name = entry.path().filename().string();
+        uint64_t number;
+        if (numberedName(name, "history-", ".base", number)) baseNumbers.push_back(number);
+        else if (numberedName(name, "segment-", ".wal", number)) segmentNumbers.push_back(number);
+    }
+
+    // The newest base that opens cleanly; a newer one can only be damaged if the disk lost a synced write
+    std::sort(baseNumbers.rbegin(), baseNumbers.rend());
+    uint64_t baseNumber = 0;
+    for (uint64_t number : baseNumbers) {
+        try {
+            base = std::make_shared<const BaseFile>(basePath(number));
+            baseNumber = number;
+            break;
+        } catch (const std::runtime_error&) {
+        }
+    }
+    uint64_t firstSegment = base ? base->nextSegment() : 0;
+
+    std::sort(segmentNumbers.begin(), segmentNumbers.end());
+    uint64_t next = firstSegment;
+    for (uint64_t number : segmentNumbers) {
+        if (number >= firstSegment) replaySegment(segmentPath(number));
+        next = std::max(next, number + 1);
+    }
+
+    // Older bases, segments already in the base and files of an interrupted compaction
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        std::string name = entry.path().filename().string();
+        uint64_t number;
+        bool obsolete = (numberedName(name, "history-", ".base", number) && (!base || number != baseNumber)) ||
+                        (numberedName(name, "segment-", ".wal", number) && number < firstSegment) ||
+                        (numberedName(name, "history-", ".base.tmp", number));
+        if (obsolete) std::filesystem::remove(entry.path());
+    }
+
+    openSegment(next);
+    if (live.points.size() >= this->compactThreshold) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        startCompaction();
+    }
+}
+
+HistoryStore::~HistoryStore() {
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        compactionDone.wait(lock, [this]() { return !compacting; });
+    }
+    if (compactor.joinable()) compactor.join();
+    if (segment != nullptr) {
+        syncFile(segment);
+        std::fclose(segment);
+    }
+}
+
+std::string HistoryStore::basePath(uint64_t number) const {
+    return (std::filesystem::path(directory) / ("history-" + std::to_string(number) + ".base")).string();
+}
+
+std::string HistoryStore::segmentPath(uint64_t number) const {
+    return (std::filesystem::path(directory) / ("segment-" + std::to_string(number) + ".wal")).string();
+}
+
+void HistoryStore::openSegment(uint64_t number) {
+    std::string path = segmentPath(number);
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) throw std::runtime_error("Cannot create history segment: " + path);
+    SegmentHeader header{};
+    std::memcpy(header.magic, segmentMagic, sizeof(segmentMagic));
+    header.version = formatVersion;
+    header.dimensions = static_cast<uint32_t>(dimensions);
+    header.byteOrder = byteOrderMark;
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+        std::fclose(file);
+        throw std::runtime_error("Cannot write history segment: " + path);
+    }
+    segment = file;
+    segmentNumber = number;
+}
+
+void HistoryStore::replaySegment(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) throw std::runtime_error("Cannot open history segment: " + path);
+    SegmentHeader header;
+    bool valid = std::fread(&header, sizeof(header), 1, file) == 1 && std::memcmp(header.magic, segmentMagic, sizeof(segmentMagic)) == 0 &&
+                 header.byteOrder == byteOrderMark;
+    if (valid && (header.version != formatVersion || header.dimensions != dimensions)) {
+        std::fclose(file);
+        throw std::runtime_error("Unsupported history segment version: " + path);
+    }
+    size_t replayed = 0;
+    SegmentRecord record;
+    while (valid && std::fread(&record, sizeof(record), 1, file) == 1 && record.checksum == checksum(record)) {
+        StoredPoint point;
+        std::copy(std::begin(record.features), std::end(record.features), point.features.begin());
+        point.label = record.label;
+        live.add(point);
+        ++replayed;
+    }
+    std::fclose(file);
+    if (replayed == 0) std::filesystem::remove(path);  // Nothing to keep; saves an empty file per restart
+}
+
+void HistoryStore::startCompaction() {
+    if (compactor.joinable()) compactor.join();  // The previous compaction has already cleared compacting
+    std::FILE* previous = segment;
+    if (!syncFile(previous)) throw std::runtime_error("Cannot write history segment: " + segmentPath(segmentNumber));
+    openSegment(segmentNumber + 1);
+    std::fclose(previous);
+    // Frozen records are only left over when the previous compaction failed; they are retried with the live ones
+    if (frozen.points.empty()) {
+        std::swap(frozen, live);
+    } else {
+        for (const StoredPoint& point : live.points) frozen.add(point);
+        live.clear();
+    }
+    compacting = true;
+    compactor = std::thread(&HistoryStore::runCompaction, this, base, segmentNumber);
+}
+
+void HistoryStore::runCompaction(std::shared_ptr<const BaseFile> source, uint64_t nextSegment) {
+    std::exception_ptr error;
+    try {
+        // Frozen records and the source base do not change while compacting is set, so no lock is needed to read them
+        size_t baseCount = source ? source->size() : 0;
+        if (baseCount + frozen.points.size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("History store is full");
+        }
+        std::vector<StoredPoint> points;
+        points.reserve(baseCount + frozen.points.size());
+        for (size_t i = 0; i < baseCount; ++i) points.push_back(source->point(i));
+        points.insert(points.end(), frozen.points.begin(), frozen.points.end());
+        std::vector<BaseNode> nodes;
+        nodes.reserve(2 * points.size() / leafSize + 1);
+        buildNode(points, 0, static_cast<uint32_t>(points.size()), nodes);
+
+        std::string path = basePath(nextSegment);
+        std::string temporary = path + ".tmp";
+        writeBase(temporary, points, nodes, nextSegment);
+        std::filesystem::rename(temporary, path);
+        syncDirectory(directory);
+        auto replacement = std::make_shared<const BaseFile>(path);
+
+        std::shared_ptr<const BaseFile> replaced;
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            replaced = std::exchange(base, replacement);
+            frozen.clear();
+        }
+        // Unmap before deleting, which Windows requires
+        replaced.reset();
+        source.reset();
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+            std::string name = entry.path().filename().string();
+            uint64_t number;
+            if ((numberedName(name, "history-", ".base", number) && number != nextSegment) ||
+                (numberedName(name, "segment-", ".wal", number) && number < nextSegment)) {
+                std::filesystem::remove(entry.path());
+            }
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    compactionError = error;
+    compacting = false;
+    compactionDone.notify_all();
+}
+
+void HistoryStore::append(const Point& point, int label) {
+    StoredPoint stored;
+    for (size_t d = 0; d < dimensions; ++d) stored.features[d] = static_cast<float>(point[d]);
+    stored.label = label;
+    appendAll({stored});
+}
+
+void HistoryStore::appendAll(const std::vector<StoredPoint>& points) {
+    std::vector<SegmentRecord> records(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        std::copy(points[i].features.begin(), points[i].features.end(), records[i].features);
+        records[i].label = points[i].label;
+        records[i].checksum = checksum(records[i]);
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    // Each run goes to the segment that is current when it joins the tail, so a compaction starting between runs
+    // takes exactly the records of the segments it retires
+    size_t first = 0;
+    while (first < points.size()) {
+        size_t run = points.size() - first;
+        if (!compacting) run = std::min(run, compactThreshold - std::min(compactThreshold - 1, live.points.size()));
+        if (std::fwrite(records.data() + first, sizeof(SegmentRecord), run, segment) != run) {
+            throw std::runtime_error("Cannot write history segment: " + segmentPath(segmentNumber));
+        }
+        live.addAll(std::span<const StoredPoint>(points).subspan(first, run));
+        first += run;
+        if (!compacting && live.points.size() >= compactThreshold) startCompaction();
+    }
+}
+
+void HistoryStore::offerAll(const Features& query, const Point& point, size_t k, KnnNeighbor* best, size_t& found) const {
+    if (base) base->search(0, query, k, best, found);
+    frozen.index.offerNearest(point, k, best, found);
+    live.index.offerNearest(point, k, best, found);
+}
+
+size_t HistoryStore::nearest(const Point& query, size_t k, KnnNeighbor* best) const {
+    if (k == 0) return 0;
+    Features features;
+    for (size_t d = 0; d < dimensions; ++d) features[d] = static_cast<float>(query[d]);
+    size_t found = 0;
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    offerAll(features, query, k, best, found);
+    return found;
+}
+
+// Queries are answered grouped by their leaf of the base, as KnnIndex::nearestBatch does
+void HistoryStore::nearestBatch(const Point* queries, size_t count, size_t k, KnnNeighbor* best, size_t* found) const {
+    std::fill(found, found + count, 0);
+    if (k == 0) return;
+    std::vector<Features> features(count);
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t d = 0; d < dimensions; ++d) features[i][d] = static_cast<float>(queries[i][d]);
+    }
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::vector<std::pair<int32_t, uint32_t>> order(count);  // (home leaf, query)
+    for (size_t i = 0; i < count; ++i) order[i] = {base ? base->homeLeaf(features[i]) : 0, static_cast<uint32_t>(i)};
+    std::sort(order.begin(), order.end());
+    for (const auto& [leaf, query] : order) offerAll(features[query], queries[query], k, best + query * k, found[query]);
+}
+
+size_t HistoryStore::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return (base ? base->size() : 0) + frozen.points.size() + live.points.size();
+}
+
+size_t HistoryStore::baseSize() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return base ? base->size() : 0;
+}
+
+std::vector<HistoryStore::StoredPoint> HistoryStore::points() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::vector<StoredPoint> result;
+    size_t baseCount = base ? base->size() : 0;
+    result.reserve(baseCount + frozen.points.size() + live.points.size());
+    for (size_t i = 0; i < baseCount; ++i) result.push_back(base->point(i));
+    result.insert(result.end(), frozen.points.begin(), frozen.points.end());
+    result.insert(result.end(), live.points.begin(), live.points.end());
+    return result;
+}
+
+void HistoryStore::flush() {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (!syncFile(segment)) throw std::runtime_error("Cannot write history segment: " + segmentPath(segmentNumber));
+}
+
+void HistoryStore::compact() {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    compactionDone.wait(lock, [this]() { return !compacting; });
+    if (live.points.empty() && frozen.points.empty()) return;
+    startCompaction();
+    compactionDone.wait(lock, [this]() { return !compacting; });
+    if (compactionError) std::rethrow_exception(std::exchange(compactionError, nullptr));
+}
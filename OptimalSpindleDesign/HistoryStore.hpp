@@ -0,0 +1,104 @@
+#ifndef HISTORY_STORE_HPP
+#define HISTORY_STORE_HPP
+
+#include "KnnIndex.hpp"
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Persistent labelled point set behind a maintenance history kept on disk. A store directory holds one immutable
+// base file and the write-ahead segments appended since it was written.
+//
+// The base file is versioned and columnar: a header, the nodes of a balanced kd-tree, then one float32 column per
+// feature and an int32 label column, all in leaf order and 64-byte aligned. It is memory-mapped and queried in
+// place, every leaf being a contiguous run of the columns handed straight to the kNN kernel, so opening a store of
+// any size costs one mapping and pages are read in as queries touch them.
+//
+// Appends go to the current segment and to an in-memory kd-tree over the records not yet in the base. Once that tail
+// reaches compactThreshold records a background thread writes a new base holding base and tail, swaps it in and
+// deletes what it replaced; appends and queries carry on meanwhile. Opening a store replays only the segments
+// written since the last compaction, and a segment cut short by a crash ends at its last intact record.
+class HistoryStore {
+public:
+    static constexpr size_t dimensions = 6;
+    static constexpr uint32_t formatVersion = 1;
+    using Index = KnnIndex<dimensions>;
+    using Point = Index::Point;
+    using Features = std::array<float, dimensions>;
+
+    struct StoredPoint {
+        Features features;
+        int32_t label;
+    };
+
+private:
+    class BaseFile;
+
+    // Records not yet in the base: frozen ones are being compacted, live ones arrived since
+    struct Tail {
+        std::vector<StoredPoint> points;
+        Index index;
+        void add(const StoredPoint& point);
+        void addAll(std::span<const StoredPoint> batch);
+        void clear();
+    };
+
+    std::string directory;
+    size_t compactThreshold;
+    mutable std::shared_mutex mutex;
+    std::shared_ptr<const BaseFile> base;
+    Tail frozen;
+    Tail live;
+    std::FILE* segment = nullptr;
+    uint64_t segmentNumber = 0;
+    bool compacting = false;
+    std::condition_variable_any compactionDone;
+    std::thread compactor;
+    std::exception_ptr compactionError;  // Why the last compaction failed; its records stay in frozen for the next one
+
+    std::string basePath(uint64_t number) const;
+    std::string segmentPath(uint64_t number) const;
+    void openSegment(uint64_t number);
+    void replaySegment(const std::string& path);
+    void startCompaction();      // Under the exclusive lock
+    void runCompaction(std::shared_ptr<const BaseFile> source, uint64_t nextSegment);
+    void offerAll(const Features& query, const Point& point, size_t k, KnnNeighbor* best, size_t& found) const;
+
+public:
+    // Opens the store in directory, creating the directory if needed
+    explicit HistoryStore(const std::string& directory, size_t compactThreshold = 65536);
+    // Waits for a running compaction and flushes the current segment
+    ~HistoryStore();
+
+    HistoryStore(const HistoryStore&) = delete;
+    HistoryStore& operator=(const HistoryStore&) = delete;
+
+    // Appends are buffered: they reach the segment file when the buffer fills, on flush() and when the store closes
+    void append(const Point& point, int label);
+    void appendAll(const std::vector<StoredPoint>& points);
+
+    // Same contract as KnnIndex::nearest; ids identify a point only within the base or the tail it came from
+    size_t nearest(const Point& query, size_t k, KnnNeighbor* best) const;
+    void nearestBatch(const Point* queries, size_t count, size_t k, KnnNeighbor* best, size_t* found) const;
+
+    size_t size() const;
+    size_t baseSize() const;
+    std::vector<StoredPoint> points() const;
+
+    // Hands buffered appends to the operating system and syncs them to disk
+    void flush();
+    // Folds the tail into a new base now and waits for it; throws if the base cannot be written
+    void compact();
+};
+
+#endif // HISTORY_STORE_HPP
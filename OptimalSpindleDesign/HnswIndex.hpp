@@ -0,0 +1,404 @@
+#ifndef HNSW_INDEX_HPP
+#define HNSW_INDEX_HPP
+
+#include "KnnKernel.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct HnswParameters {
+    size_t links = 16;          // Neighbours kept per node on the upper layers; the bottom layer keeps twice as many
+    size_t buildBreadth = 100;  // Candidate list size while inserting; higher builds a better graph, more slowly
+    size_t searchBreadth = 64;  // Candidate list size while querying (at least k); the recall/latency dial
+    uint64_t seed = 42;         // Layer assignment
+};
+
+// Approximate k-nearest-neighbour index: a hierarchical navigable small-world graph (Malkov and Yashunin). Every
+// point sits on the bottom layer and on each higher layer with geometrically falling probability. A query descends
+// greedily through the sparse upper layers and then runs a best-first search of searchBreadth candidates on the
+// bottom layer, so its cost grows with log N and searchBreadth rather than with N. Results can miss true neighbours;
+// raise searchBreadth to trade latency for recall.
+//
+// Same interface as KnnIndex. Removal only marks a point deleted, since it may still route searches; the graph is
+// rebuilt from the live points once deleted ones outnumber them.
+template<size_t Dimensions>
+class HnswIndex {
+public:
+    using Point = std::array<double, Dimensions>;
+    using Neighbor = KnnNeighbor;
+
+private:
+    using Features = std::array<float, Dimensions>;
+    using Candidate = std::pair<float, uint32_t>;  // (squared distance, node)
+
+    static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+    static constexpr char fileMagic[8] = {'S', 'P', 'N', 'D', 'H', 'N', 'S', 'W'};
+    static constexpr uint32_t fileVersion = 1;
+
+    HnswParameters parameters;
+    std::vector<Features> features;                 // Per node
+    std::vector<int> labels;
+    std::vector<uint32_t> nodeIds;                  // External id of each node
+    std::vector<char> deleted;
+    std::vector<uint8_t> levels;                    // Highest layer of each node
+    std::vector<uint32_t> bottomLinks;              // bottomStride() words per node: count, then neighbours
+    std::vector<std::vector<uint32_t>> upperLinks;  // upperStride() words per layer above the bottom, per node
+    std::vector<uint32_t> nodeOf;                   // Node of each external id, or none
+    uint32_t entryPoint = none;
+    int topLevel = -1;
+    size_t liveCount = 0;
+    std::mt19937_64 rng;
+
+    size_t bottomStride() const { return 2 * parameters.links + 1; }
+    size_t upperStride() const { return parameters.links + 1; }
+
+    uint32_t* linksOf(uint32_t node, int level) {
+        if (level == 0) return bottomLinks.data() + node * bottomStride();
+        return upperLinks[node].data() + (level - 1) * upperStride();
+    }
+    const uint32_t* linksOf(uint32_t node, int level) const {
+        if (level == 0) return bottomLinks.data() + node * bottomStride();
+        return upperLinks[node].data() + (level - 1) * upperStride();
+    }
+
+    static Features toFeatures(const Point& point) {
+        Features result;
+        for (size_t d = 0; d < Dimensions; ++d) result[d] = static_cast<float>(point[d]);
+        return result;
+    }
+
+    static float distance(const Features& a, const Features& b) {
+        float sum = 0.0f;
+        for (size_t d = 0; d < Dimensions; ++d) {
+            float difference = a[d] - b[d];
+            sum += difference * difference;
+        }
+        return sum;
+    }
+
+    int randomLevel() {
+        double scale = 1.0 / std::log(static_cast<double>(std::max<size_t>(2, parameters.links)));
+        double draw = std::uniform_real_distribution<double>(std::numeric_limits<double>::min(), 1.0)(rng);
+        return std::min(static_cast<int>(-std::log(draw) * scale), 31);
+    }
+
+    // Visited marks reused across queries on the same thread; a new epoch clears them in O(1)
+    struct VisitMarks {
+        std::vector<uint32_t> marks;
+        uint32_t epoch = 0;
+    };
+
+    static VisitMarks& visitMarks(size_t nodeCount) {
+        thread_local VisitMarks visits;
+        if (visits.marks.size() < nodeCount) visits.marks.resize(nodeCount, 0);
+        if (++visits.epoch == 0) {
+            std::fill(visits.marks.begin(), visits.marks.end(), 0);
+            visits.epoch = 1;
+        }
+        return visits;
+    }
+
+    // Moves entry greedily towards query on one layer
+    void greedyDescend(const Features& query, int level, uint32_t& entry, float& entryDistance) const {
+        bool moved = true;
+        while (moved) {
+            moved = false;
+            const uint32_t* links = linksOf(entry, level);
+            for (uint32_t i = 1; i <= links[0]; ++i) {
+                float candidate = distance(query, features[links[i]]);
+                if (candidate < entryDistance) {
+                    entryDistance = candidate;
+                    entry = links[i];
+                    moved = true;
+                }
+            }
+        }
+    }
+
+    // Best-first search of one layer from entry; returns up to breadth nodes, closest first
+    std::vector<Candidate> searchLayer(const Features& query, uint32_t entry, float entryDistance, size_t breadth, int level) const {
+        VisitMarks& visits = visitMarks(features.size());
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> frontier;  // Closest on top
+        std::priority_queue<Candidate> results;  // Farthest on top
+        frontier.push({entryDistance, entry});
+        results.push({entryDistance, entry});
+        visits.marks[entry] = visits.epoch;
+        while (!frontier.empty()) {
+            Candidate current = frontier.top();
+            if (current.first > results.top().first && results.size() >= breadth) break;
+            frontier.pop();
+            const uint32_t* links = linksOf(current.second, level);
+            for (uint32_t i = 1; i <= links[0]; ++i) {
+                uint32_t next = links[i];
+                if (visits.marks[next] == visits.epoch) continue;
+                visits.marks[next] = visits.epoch;
+                float nextDistance = distance(query, features[next]);
+                if (results.size() < breadth || nextDistance < results.top().first) {
+                    frontier.push({nextDistance, next});
+                    results.push({nextDistance, next});
+                    if (results.size() > breadth) results.pop();
+                }
+            }
+        }
+        std::vector<Candidate> ordered(results.size());
+        for (size_t i = ordered.size(); i-- > 0; results.pop()) ordered[i] = results.top();
+        return ordered;
+    }
+
+    // Keeps up to limit candidates (closest first) that are closer to the new node than to any neighbour already
+    // kept, which spreads the links over directions instead of bunching them in one cluster
+    std::vector<uint32_t> selectNeighbors(const std::vector<Candidate>& candidates, size_t limit) const {
+        std::vector<uint32_t> kept;
+        for (const Candidate& candidate : candidates) {
+            if (kept.size() == limit) break;
+            bool diverse = true;
+            for (uint32_t other : kept) {
+                if (distance(features[candidate.second], features[other]) < candidate.first) {
+                    diverse = false;
+                    break;
+                }
+            }
+            if (diverse) kept.push_back(candidate.second);
+        }
+        return kept;
+    }
+
+    void setLinks(uint32_t node, int level, const std::vector<uint32_t>& neighbours) {
+        uint32_t* links = linksOf(node, level);
+        links[0] = static_cast<uint32_t>(neighbours.size());
+        std::copy(neighbours.begin(), neighbours.end(), links + 1);
+    }
+
+    void connect(uint32_t from, uint32_t to, int level) {
+        uint32_t* links = linksOf(from, level);
+        size_t capacity = level == 0 ? 2 * parameters.links : parameters.links;
+        if (links[0] < capacity) {
+            links[++links[0]] = to;
+            return;
+        }
+        std::vector<Candidate> candidates;
+        candidates.reserve(capacity + 1);
+        candidates.push_back({distance(features[from], features[to]), to});
+        for (uint32_t i = 1; i <= links[0]; ++i) candidates.push_back({distance(features[from], features[links[i]]), links[i]});
+        std::sort(candidates.begin(), candidates.end());
+        setLinks(from, level, selectNeighbors(candidates, capacity));
+    }
+
+    uint32_t addNode(uint32_t id, const Features& point, int label) {
+        uint32_t node = static_cast<uint32_t>(features.size());
+        int level = randomLevel();
+        features.push_back(point);
+        labels.push_back(label);
+        nodeIds.push_back(id);
+        deleted.push_back(0);
+        levels.push_back(static_cast<uint8_t>(level));
+        bottomLinks.resize(bottomLinks.size() + bottomStride(), 0);
+        upperLinks.emplace_back(level * upperStride(), 0);
+        if (entryPoint == none) {
+            entryPoint = node;
+            topLevel = level;
+            return node;
+        }
+
+        uint32_t entry = entryPoint;
+        float entryDistance = distance(point, features[entry]);
+        for (int layer = topLevel; layer > level; --layer) greedyDescend(point, layer, entry, entryDistance);
+        for (int layer = std::min(level, topLevel); layer >= 0; --layer) {
+            std::vector<Candidate> candidates = searchLayer(point, entry, entryDistance, parameters.buildBreadth, layer);
+            std::vector<uint32_t> neighbours = selectNeighbors(candidates, parameters.links);
+            setLinks(node, layer, neighbours);
+            for (uint32_t neighbour : neighbours) connect(neighbour, node, layer);
+            entry = candidates.front().second;
+            entryDistance = candidates.front().first;
+        }
+        if (level > topLevel) {
+            entryPoint = node;
+            topLevel = level;
+        }
+        return node;
+    }
+
+    // Bottom-layer candidates for query, closest first
+    std::vector<Candidate> candidatesFor(const Features& query, size_t k) const {
+        uint32_t entry = entryPoint;
+        float entryDistance = distance(query, features[entry]);
+        for (int layer = topLevel; layer > 0; --layer) greedyDescend(query, layer, entry, entryDistance);
+        return searchLayer(query, entry, entryDistance, std::max(parameters.searchBreadth, k), 0);
+    }
+
+public:
+    explicit HnswIndex(const HnswParameters& parameters = HnswParameters()) : parameters(parameters), rng(parameters.seed) {
+        this->parameters.links = std::max<size_t>(2, parameters.links);
+        this->parameters.buildBreadth = std::max<size_t>(1, parameters.buildBreadth);
+    }
+
+    size_t size() const { return liveCount; }
+    const HnswParameters& settings() const { return parameters; }
+    // Only the search breadth can change once points are in the graph
+    void setSearchBreadth(size_t breadth) { parameters.searchBreadth = std::max<size_t>(1, breadth); }
+
+    void clear() {
+        features.clear();
+        labels.clear();
+        nodeIds.clear();
+        deleted.clear();
+        levels.clear();
+        bottomLinks.clear();
+        upperLinks.clear();
+        nodeOf.clear();
+        entryPoint = none;
+        topLevel = -1;
+        liveCount = 0;
+    }
+
+    void reserve(size_t capacity) {
+        features.reserve(capacity);
+        labels.reserve(capacity);
+        nodeIds.reserve(capacity);
+        deleted.reserve(capacity);
+        levels.reserve(capacity);
+        bottomLinks.reserve(capacity * bottomStride());
+        upperLinks.reserve(capacity);
+        nodeOf.reserve(capacity);
+    }
+
+    // id must not be in the index; ids index an internal table, so keep them dense
+    void insert(uint32_t id, const Point& coordinates, int label) {
+        if (id >= nodeOf.size()) nodeOf.resize(id + 1, none);
+        nodeOf[id] = addNode(id, toFeatures(coordinates), label);
+        ++liveCount;
+    }
+
+    bool remove(uint32_t id) {
+        if (id >= nodeOf.size() || nodeOf[id] == none) return false;
+        deleted[nodeOf[id]] = 1;
+        nodeOf[id] = none;
+        --liveCount;
+        if (features.size() - liveCount > std::max<size_t>(liveCount, 1024)) rebuild();
+        return true;
+    }
+
+    // Builds a fresh graph over the live points, dropping deleted ones
+    void rebuild() {
+        std::vector<Features> oldFeatures = std::move(features);
+        std::vector<int> oldLabels = std::move(labels);
+        std::vector<uint32_t> oldIds = std::move(nodeIds);
+        std::vector<char> oldDeleted = std::move(deleted);
+        size_t idCount = nodeOf.size();
+        clear();
+        nodeOf.assign(idCount, none);
+        reserve(oldFeatures.size());
+        for (size_t node = 0; node < oldFeatures.size(); ++node) {
+            if (oldDeleted[node]) continue;
+            nodeOf[oldIds[node]] = addNode(oldIds[node], oldFeatures[node], oldLabels[node]);
+            ++liveCount;
+        }
+    }
+
+    // Writes up to k approximate nearest points to best, closest first, and returns how many were written. Points
+    // whose id excluded accepts are skipped but still route the search.
+    template<typename Excluded = KnnKeepAll>
+    size_t nearest(const Point& query, size_t k, Neighbor* best, const Excluded& excluded = {}) const {
+        size_t found = 0;
+        if (k == 0 || liveCount == 0) return 0;
+        for (const Candidate& candidate : candidatesFor(toFeatures(query), k)) {
+            if (deleted[candidate.second] || excluded(nodeIds[candidate.second])) continue;
+            offerNeighbor({candidate.first, labels[candidate.second], nodeIds[candidate.second]}, k, best, found);
+        }
+        return found;
+    }
+
+    template<typename Excluded = KnnKeepAll>
+    void nearestBatch(const Point* queries, size_t count, size_t k, Neighbor* best, size_t* found, const Excluded& excluded = {}) const {
+        for (size_t i = 0; i < count; ++i) found[i] = nearest(queries[i], k, best + i * k, excluded);
+    }
+
+    // Calls visitor(id, features, label) for every live point
+    template<typename Visitor>
+    void forEach(Visitor&& visitor) const {
+        for (size_t node = 0; node < features.size(); ++node) {
+            if (!deleted[node]) visitor(nodeIds[node], features[node], labels[node]);
+        }
+    }
+
+    // Binary, native-endian graph file; save() then load() restores the index exactly, without rebuilding
+    void save(const std::string& path) const {
+        std::ofstream file(path, std::ios::binary);
+        if (!file) throw std::runtime_error("Cannot write index file: " + path);
+        uint64_t header[6] = {Dimensions, parameters.links, features.size(), nodeOf.size(), entryPoint,
+                              static_cast<uint64_t>(static_cast<int64_t>(topLevel))};
+        file.write(fileMagic, sizeof(fileMagic));
+        file.write(reinterpret_cast<const char*>(&fileVersion), sizeof(fileVersion));
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(features.data()), features.size() * sizeof(Features));
+        file.write(reinterpret_cast<const char*>(labels.data()), labels.size() * sizeof(int));
+        file.write(reinterpret_cast<const char*>(nodeIds.data()), nodeIds.size() * sizeof(uint32_t));
+        file.write(deleted.data(), deleted.size());
+        file.write(reinterpret_cast<const char*>(levels.data()), levels.size());
+        file.write(reinterpret_cast<const char*>(bottomLinks.data()), bottomLinks.size() * sizeof(uint32_t));
+        for (const auto& links : upperLinks) file.write(reinterpret_cast<const char*>(links.data()), links.size() * sizeof(uint32_t));
+        if (!file) throw std::runtime_error("Cannot write index file: " + path);
+    }
+
+    // Replaces the contents with a saved graph; its link count overrides parameters.links
+    void load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) throw std::runtime_error("Cannot open index file: " + path);
+        char magic[sizeof(fileMagic)];
+        uint32_t version = 0;
+        uint64_t header[6];
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char*>(&version), sizeof(version));
+        file.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (!file || std::memcmp(magic, fileMagic, sizeof(magic)) != 0) throw std::runtime_error("Not an index file: " + path);
+        if (version != fileVersion || header[0] != Dimensions || header[1] < 2) {
+            throw std::runtime_error("Unsupported index file version: " + path);
+        }
+        clear();
+        parameters.links = header[1];
+        size_t nodeCount = header[2];
+        features.resize(nodeCount);
+        labels.resize(nodeCount);
+        nodeIds.resize(nodeCount);
+        deleted.resize(nodeCount);
+        levels.resize(nodeCount);
+        bottomLinks.resize(nodeCount * bottomStride());
+        file.read(reinterpret_cast<char*>(features.data()), nodeCount * sizeof(Features));
+        file.read(reinterpret_cast<char*>(labels.data()), nodeCount * sizeof(int));
+        file.read(reinterpret_cast<char*>(nodeIds.data()), nodeCount * sizeof(uint32_t));
+        file.read(deleted.data(), nodeCount);
+        file.read(reinterpret_cast<char*>(levels.data()), nodeCount);
+        file.read(reinterpret_cast<char*>(bottomLinks.data()), bottomLinks.size() * sizeof(uint32_t));
+        upperLinks.resize(nodeCount);
+        for (size_t node = 0; node < nodeCount; ++node) {
+            upperLinks[node].resize(levels[node] * upperStride());
+            file.read(reinterpret_cast<char*>(upperLinks[node].data()), upperLinks[node].size() * sizeof(uint32_t));
+        }
+        if (!file || (nodeCount > 0 && header[4] >= nodeCount)) {
+            clear();
+            throw std::runtime_error("Truncated index file: " + path);
+        }
+        entryPoint = static_cast<uint32_t>(header[4]);
+        topLevel = static_cast<int>(static_cast<int64_t>(header[5]));
+        nodeOf.assign(header[3], none);
+        for (size_t node = 0; node < nodeCount; ++node) {
+            if (deleted[node]) continue;
+            if (nodeIds[node] >= nodeOf.size()) nodeOf.resize(nodeIds[node] + 1, none);
+            nodeOf[nodeIds[node]] = static_cast<uint32_t>(node);
+            ++liveCount;
+        }
+    }
+};
+
+#endif // HNSW_INDEX_HPP
@@ -0,0 +1,94 @@
+#ifndef INITIAL_DESIGN_HPP
+#define INITIAL_DESIGN_HPP
+
+#include "MogaProblem.hpp"
+#include "OptimizationSettings.hpp"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Initial populations shared by the search engines: warm-start seeds first, then random or Latin hypercube samples
+
+template<MogaProblem Problem>
+Genome<Problem::continuousGenes, Problem::categoricalGenes> generateRandomGenome(std::mt19937& rng) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    Genome<Problem::continuousGenes, Problem::categoricalGenes> genome;
+    for (auto& gene : genome.continuous) gene = dist(rng);
+    for (size_t i = 0; i < Problem::categoricalGenes; ++i) {
+        genome.categorical[i] = std::min(Problem::categoryCounts[i] - 1, static_cast<int>(dist(rng) * Problem::categoryCounts[i]));
+    }
+    return genome;
+}
+
+template<std::size_t Dimensions>
+std::vector<std::array<double, Dimensions>> generateLatinHypercube(size_t count, int designCandidates, std::mt19937& rng) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<std::array<double, Dimensions>> bestDesign;
+    double bestSpacing = -1.0;
+
+    // Keep the candidate design whose closest pair of points is farthest apart (maximin)
+    for (int candidate = 0; candidate < std::max(1, designCandidates); ++candidate) {
+        std::vector<std::array<double, Dimensions>> design(count);
+        std::vector<size_t> strata(count);
+        for (size_t d = 0; d < Dimensions; ++d) {
+            std::iota(strata.begin(), strata.end(), 0);
+            std::shuffle(strata.begin(), strata.end(), rng);
+            for (size_t i = 0; i < count; ++i) {
+                design[i][d] = (strata[i] + dist(rng)) / count;
+            }
+        }
+
+        double spacing = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t j = i + 1; j < count; ++j) {
+                double distance = 0.0;
+                for (size_t d = 0; d < Dimensions; ++d) {
+                    double diff = design[i][d] - design[j][d];
+                    distance += diff * diff;
+                }
+                spacing = std::min(spacing, distance);
+            }
+        }
+        if (spacing > bestSpacing) {
+            bestSpacing = spacing;
+            bestDesign = std::move(design);
+        }
+    }
+    return bestDesign;
+}
+
+template<MogaProblem Problem>
+std::vector<Genome<Problem::continuousGenes, Problem::categoricalGenes>> generateInitialGenomes(
+    size_t count, const std::vector<Genome<Problem::continuousGenes, Problem::categoricalGenes>>& seedGenomes,
+    const OptimizationSettings& settings, std::mt19937& rng) {
+    using GenomeType = Genome<Problem::continuousGenes, Problem::categoricalGenes>;
+    std::vector<GenomeType> initial(seedGenomes.begin(), seedGenomes.begin() + std::min(count, seedGenomes.size()));
+    size_t remaining = count - initial.size();
+    if (remaining == 0) return initial;
+    if (settings.initialization == InitializationMethod::Random) {
+        for (size_t i = 0; i < remaining; ++i) initial.push_back(generateRandomGenome<Problem>(rng));
+        return initial;
+    }
+
+    std::vector<GenomeType> sampled(remaining);
+    if constexpr (Problem::continuousGenes > 0) {
+        auto design = generateLatinHypercube<Problem::continuousGenes>(remaining, settings.designCandidates, rng);
+        for (size_t i = 0; i < remaining; ++i) sampled[i].continuous = design[i];
+    }
+
+    // Every option of a categorical gene appears floor(n/k) or ceil(n/k) times
+    std::vector<int> assignment(remaining);
+    for (size_t gene = 0; gene < Problem::categoricalGenes; ++gene) {
+        for (size_t i = 0; i < remaining; ++i) assignment[i] = static_cast<int>(i % Problem::categoryCounts[gene]);
+        std::shuffle(assignment.begin(), assignment.end(), rng);
+        for (size_t i = 0; i < remaining; ++i) sampled[i].categorical[gene] = assignment[i];
+    }
+
+    initial.insert(initial.end(), sampled.begin(), sampled.end());
+    return initial;
+}
+
+#endif // INITIAL_DESIGN_HPP
@@ -0,0 +1,133 @@
+#ifndef KD_TREE_HPP
+#define KD_TREE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// Metric policies supply distance(query, point) and a lowerBound(query, lower, upper) that never exceeds the distance to any
+// point inside the box; values are only compared, so a policy may return squared or signed distances
+struct EuclideanMetric {
+    static double distance(const std::vector<double>& query, const std::vector<double>& point) {
+        double sum = 0.0;
+        for (size_t i = 0; i < query.size(); ++i) sum += (point[i] - query[i]) * (point[i] - query[i]);
+        return sum; // Squared
+    }
+    static double lowerBound(const std::vector<double>& query, const std::vector<double>& lower, const std::vector<double>& upper) {
+        double sum = 0.0;
+        for (size_t i = 0; i < query.size(); ++i) {
+            double gap = std::max({lower[i] - query[i], query[i] - upper[i], 0.0});
+            sum += gap * gap;
+        }
+        return sum;
+    }
+};
+
+struct ManhattanMetric {
+    static double distance(const std::vector<double>& query, const std::vector<double>& point) {
+        double sum = 0.0;
+        for (size_t i = 0; i < query.size(); ++i) sum += std::abs(point[i] - query[i]);
+        return sum;
+    }
+    static double lowerBound(const std::vector<double>& query, const std::vector<double>& lower, const std::vector<double>& upper) {
+        double sum = 0.0;
+        for (size_t i = 0; i < query.size(); ++i) sum += std::max({lower[i] - query[i], query[i] - upper[i], 0.0});
+        return sum;
+    }
+};
+
+// Static kd-tree over a point set; every node keeps its bounding box so any metric policy can prune with it
+template<typename Metric>
+class KdTree {
+private:
+    struct Node {
+        size_t begin;
+        size_t end;
+        std::vector<double> lower;
+        std::vector<double> upper;
+        int left = -1;
+        int right = -1;
+    };
+
+    std::vector<std::vector<double>> points;
+    std::vector<size_t> order;   // Point indices permuted so every node covers a contiguous range
+    std::vector<Node> nodes;
+    size_t leafSize;
+
+    int build(size_t begin, size_t end) {
+        Node node;
+        node.begin = begin;
+        node.end = end;
+        const size_t dimensions = points[order[begin]].size();
+        node.lower.assign(dimensions, std::numeric_limits<double>::infinity());
+        node.upper.assign(dimensions, -std::numeric_limits<double>::infinity());
+        for (size_t i = begin; i < end; ++i) {
+            for (size_t d = 0; d < dimensions; ++d) {
+                node.lower[d] = std::min(node.lower[d], points[order[i]][d]);
+                node.upper[d] = std::max(node.upper[d], points[order[i]][d]);
+            }
+        }
+        int index = static_cast<int>(nodes.size());
+        nodes.push_back(node);
+        if (end - begin <= leafSize) return index;
+
+        // Split at the median of the widest dimension
+        size_t axis = 0;
+        for (size_t d = 1; d < dimensions; ++d) {
+            if (node.upper[d] - node.lower[d] > node.upper[axis] - node.lower[axis]) axis = d;
+        }
+        size_t middle = begin + (end - begin) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [&](size_t a, size_t b) {
+            return points[a][axis] < points[b][axis];
+        });
+        int left = build(begin, middle);
+        int right = build(middle, end);
+        nodes[index].left = left;
+        nodes[index].right = right;
+        return index;
+    }
+
+    void search(int nodeIndex, const std::vector<double>& query, size_t skip, std::pair<size_t, double>& best) const {
+        const Node& node = nodes[nodeIndex];
+        if (node.left < 0) {
+            for (size_t i = node.begin; i < node.end; ++i) {
+                if (order[i] == skip) continue;
+                double distance = Metric::distance(query, points[order[i]]);
+                if (distance < best.second) best = {order[i], distance};
+            }
+            return;
+        }
+        // Visit the closer child first so the farther one is more likely to be pruned
+        double leftBound = Metric::lowerBound(query, nodes[node.left].lower, nodes[node.left].upper);
+        double rightBound = Metric::lowerBound(query, nodes[node.right].lower, nodes[node.right].upper);
+        int first = node.left;
+        int second = node.right;
+        if (rightBound < leftBound) {
+            std::swap(first, second);
+            std::swap(leftBound, rightBound);
+        }
+        if (leftBound < best.second) search(first, query, skip, best);
+        if (rightBound < best.second) search(second, query, skip, best);
+    }
+
+public:
+    explicit KdTree(const std::vector<std::vector<double>>& points, size_t leafSize = 8)
+        : points(points), order(points.size()), leafSize(std::max<size_t>(1, leafSize)) {
+        std::iota(order.begin(), order.end(), 0);
+        if (!points.empty()) build(0, points.size());
+    }
+
+    size_t size() const { return points.size(); }
+
+    // Index of the closest point and its metric value; skip excludes one index (e.g. the query itself)
+    std::pair<size_t, double> nearest(const std::vector<double>& query, size_t skip = std::numeric_limits<size_t>::max()) const {
+        std::pair<size_t, double> best = {std::numeric_limits<size_t>::max(), std::numeric_limits<double>::infinity()};
+        if (!nodes.empty()) search(0, query, skip, best);
+        return best;
+    }
+};
+
+#endif // KD_TREE_HPP
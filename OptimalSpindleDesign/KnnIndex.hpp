@@ -0,0 +1,320 @@
+#ifndef KNN_INDEX_HPP
+#define KNN_INDEX_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "KnnKernel.hpp"
+#include <limits>
+#include <span>
+#include <vector>
+
+// Median split of [first, last) along one axis of a kd-tree whose nodes route a coordinate below split to the left
+// child. Points below the median go left and the rest right; when the median ties the smallest coordinate (a floor
+// value shared by many points), the tied points go left instead and split moves just past them, so heavily tied data
+// still halves rather than piling into one leaf. Returns the first right-hand point, which is last only when every
+// coordinate along the axis is equal.
+template<typename Iterator, typename Coordinate>
+Iterator partitionAtMedian(Iterator first, Iterator last, Coordinate coordinate, float& split) {
+    Iterator middle = first + (last - first) / 2;
+    std::nth_element(first, middle, last, [&](const auto& a, const auto& b) { return coordinate(a) < coordinate(b); });
+    float median = coordinate(*middle);
+    Iterator boundary = std::partition(first, last, [&](const auto& point) { return coordinate(point) < median; });
+    if (boundary != first) {
+        split = median;
+        return boundary;
+    }
+    split = std::nextafter(median, std::numeric_limits<float>::infinity());
+    return std::partition(first, last, [&](const auto& point) { return coordinate(point) <= median; });
+}
+
+// Dynamic kd-tree for k-nearest-neighbour queries over labelled points in a fixed-dimensional feature space.
+// Points are inserted and removed one at a time under caller-chosen ids. An insert descends to its leaf, widening the
+// bounding boxes on the way, and a leaf that overflows splits at the median of its widest dimension. The whole tree
+// is rebuilt balanced once the inserts and removals since the last build match its size, so updates cost amortized
+// O(log N) and queries stay logarithmic even under steady churn.
+template<size_t Dimensions>
+class KnnIndex {
+public:
+    using Point = std::array<double, Dimensions>;
+    using Neighbor = KnnNeighbor;
+
+private:
+    using Block = FeatureBlock<Dimensions>;
+    using Features = typename Block::Features;
+
+    struct Entry {
+        Features point;
+        int label;
+        uint32_t id;
+    };
+
+    // Leaves keep float32 copies of their points column-wise, so a leaf scan is one SIMD kernel call
+    struct Node {
+        Features lower;
+        Features upper;
+        int left = -1;   // -1 for a leaf
+        int right = -1;
+        size_t axis = 0;
+        float split = 0.0f;
+        Block members;   // Leaves only
+    };
+
+    static constexpr size_t leafSize = 32;
+
+    std::vector<Features> points;  // Indexed by id; the source of rebuilds
+    std::vector<int> labels;
+    std::vector<char> live;        // Whether each id is currently in the index
+    std::vector<Node> nodes;
+    size_t count = 0;
+    size_t builtSize = 0;          // Point count at the last balanced build
+    size_t changes = 0;            // Inserts and removals since then
+
+    static Features toFeatures(const Point& point) {
+        Features features;
+        for (size_t d = 0; d < Dimensions; ++d) features[d] = static_cast<float>(point[d]);
+        return features;
+    }
+
+    static float boxDistance(const Features& query, const Node& node) {
+        float sum = 0.0f;
+        for (size_t d = 0; d < Dimensions; ++d) {
+            float gap = std::max({node.lower[d] - query[d], query[d] - node.upper[d], 0.0f});
+            sum += gap * gap;
+        }
+        return sum;
+    }
+
+    static void fitBox(Node& node, const Entry* first, const Entry* last) {
+        node.lower.fill(std::numeric_limits<float>::infinity());
+        node.upper.fill(-std::numeric_limits<float>::infinity());
+        for (const Entry* entry = first; entry != last; ++entry) {
+            for (size_t d = 0; d < Dimensions; ++d) {
+                node.lower[d] = std::min(node.lower[d], entry->point[d]);
+                node.upper[d] = std::max(node.upper[d], entry->point[d]);
+            }
+        }
+    }
+
+    static void fill(Node& node, const Entry* first, const Entry* last) {
+        node.members.clear();
+        node.members.reserve(last - first);
+        for (const Entry* entry = first; entry != last; ++entry) node.members.push(entry->point, entry->label, entry->id);
+    }
+
+    // Turns leaf nodeIndex into an internal node over two balanced leaves, recursing while they stay too large
+    void split(int nodeIndex) {
+        const Block& block = nodes[nodeIndex].members;
+        std::vector<Entry> entries(block.size());
+        for (size_t i = 0; i < block.size(); ++i) entries[i] = {block.features(i), block.label(i), block.id(i)};
+        // Removals leave the box loose; the leaf's own extent picks the axis that actually separates its points
+        fitBox(nodes[nodeIndex], entries.data(), entries.data() + entries.size());
+        splitEntries(nodeIndex, entries.data(), entries.data() + entries.size());
+    }
+
+    // Partitions [first, last) in place down to the leaves, so a rebuild moves each entry once per level
+    void splitEntries(int nodeIndex, Entry* first, Entry* last) {
+        size_t axis = 0;
+        for (size_t d = 1; d < Dimensions; ++d) {
+            if (nodes[nodeIndex].upper[d] - nodes[nodeIndex].lower[d] > nodes[nodeIndex].upper[axis] - nodes[nodeIndex].lower[axis]) {
+                axis = d;
+            }
+        }
+        // Points at or above the split value go right, the same rule insert() and remove() follow
+        float splitValue = 0.0f;
+        Entry* boundary = partitionAtMedian(first, last, [axis](const Entry& entry) { return entry.point[axis]; }, splitValue);
+        if (boundary == last) {
+            fill(nodes[nodeIndex], first, last);  // No extent along the widest axis, so the points coincide
+            return;
+        }
+
+        Node left;
+        Node right;
+        fitBox(left, first, boundary);
+        fitBox(right, boundary, last);
+        int leftIndex = static_cast<int>(nodes.size());
+        nodes.push_back(std::move(left));
+        nodes.push_back(std::move(right));
+        nodes[nodeIndex].members.clear();
+        nodes[nodeIndex].axis = axis;
+        nodes[nodeIndex].split = splitValue;
+        nodes[nodeIndex].left = leftIndex;
+        nodes[nodeIndex].right = leftIndex + 1;
+        if (static_cast<size_t>(boundary - first) > leafSize) splitEntries(leftIndex, first, boundary);
+        else fill(nodes[leftIndex], first, boundary);
+        if (static_cast<size_t>(last - boundary) > leafSize) splitEntries(leftIndex + 1, boundary, last);
+        else fill(nodes[leftIndex + 1], boundary, last);
+    }
+
+    template<typename Excluded>
+    void search(int nodeIndex, const Features& query, size_t k, Neighbor* best, size_t& found, const Excluded& excluded) const {
+        const Node& node = nodes[nodeIndex];
+        if (node.left < 0) {
+            node.members.nearest(query, k, best, found, excluded);
+            return;
+        }
+        int first = node.left;
+        int second = node.right;
+        if (query[node.axis] >= node.split) std::swap(first, second);
+        for (int child : {first, second}) {
+            if (found == k && boxDistance(query, nodes[child]) > best[k - 1].distance) continue;
+            search(child, query, k, best, found, excluded);
+        }
+    }
+
+public:
+    size_t size() const { return count; }
+
+    void clear() {
+        points.clear();
+        labels.clear();
+        live.clear();
+        nodes.clear();
+        count = 0;
+        builtSize = 0;
+        changes = 0;
+    }
+
+    void reserve(size_t capacity) {
+        points.reserve(capacity);
+        labels.reserve(capacity);
+        live.reserve(capacity);
+    }
+
+    // id must not be in the index; ids index an internal table, so keep them dense
+    void insert(uint32_t id, const Point& coordinates, int label) {
+        if (id >= points.size()) {
+            points.resize(id + 1);
+            labels.resize(id + 1);
+            live.resize(id + 1, 0);
+        }
+        Features point = toFeatures(coordinates);
+        points[id] = point;
+        labels[id] = label;
+        live[id] = 1;
+        ++count;
+        if (nodes.empty() || ++changes >= std::max(builtSize, leafSize)) {
+            rebuild();
+            return;
+        }
+
+        int nodeIndex = 0;
+        while (true) {
+            Node& node = nodes[nodeIndex];
+            for (size_t d = 0; d < Dimensions; ++d) {
+                node.lower[d] = std::min(node.lower[d], point[d]);
+                node.upper[d] = std::max(node.upper[d], point[d]);
+            }
+            if (node.left < 0) break;
+            nodeIndex = point[node.axis] < node.split ? node.left : node.right;
+        }
+        nodes[nodeIndex].members.push(point, label, id);
+        if (nodes[nodeIndex].members.size() > 2 * leafSize) split(nodeIndex);
+    }
+
+    // insert() for points under consecutive ids from firstId. A batch that would trigger a rebuild anyway skips the
+    // per-point descents and rebuilds once, which makes bulk loading O(N log N) with small constants.
+    void insertBatch(uint32_t firstId, std::span<const Point> coordinates, std::span<const int> pointLabels) {
+        if (!nodes.empty() && changes + coordinates.size() < std::max(builtSize, leafSize)) {
+            for (size_t i = 0; i < coordinates.size(); ++i) insert(firstId + static_cast<uint32_t>(i), coordinates[i], pointLabels[i]);
+            return;
+        }
+        size_t end = firstId + coordinates.size();
+        if (end > points.size()) {
+            points.resize(end);
+            labels.resize(end);
+            live.resize(end, 0);
+        }
+        for (size_t i = 0; i < coordinates.size(); ++i) {
+            points[firstId + i] = toFeatures(coordinates[i]);
+            labels[firstId + i] = pointLabels[i];
+            live[firstId + i] = 1;
+        }
+        count += coordinates.size();
+        rebuild();
+    }
+
+    // Removes id from its leaf; boxes keep their extent until the next rebuild, which only loosens pruning
+    bool remove(uint32_t id) {
+        if (id >= live.size() || !live[id]) return false;
+        live[id] = 0;
+        --count;
+        int nodeIndex = 0;
+        while (nodes[nodeIndex].left >= 0) {
+            const Node& node = nodes[nodeIndex];
+            nodeIndex = points[id][node.axis] < node.split ? node.left : node.right;
+        }
+        Block& members = nodes[nodeIndex].members;
+        for (size_t position = 0; position < members.size(); ++position) {
+            if (members.id(position) == id) {
+                members.erase(position);
+                break;
+            }
+        }
+        if (++changes >= std::max(builtSize, leafSize)) rebuild();
+        return true;
+    }
+
+    // Rebalances the tree over the points currently in the index
+    void rebuild() {
+        nodes.clear();
+        builtSize = count;
+        changes = 0;
+        if (count == 0) return;
+        std::vector<Entry> entries;
+        entries.reserve(count);
+        for (size_t i = 0; i < points.size(); ++i) {
+            if (live[i]) entries.push_back({points[i], labels[i], static_cast<uint32_t>(i)});
+        }
+        Node root;
+        fitBox(root, entries.data(), entries.data() + entries.size());
+        nodes.reserve(2 * count / leafSize + 1);
+        nodes.push_back(std::move(root));
+        if (entries.size() > leafSize) splitEntries(0, entries.data(), entries.data() + entries.size());
+        else fill(nodes[0], entries.data(), entries.data() + entries.size());
+    }
+
+    // Writes up to k nearest points to best, closest first, and returns how many were written. Points whose id
+    // excluded accepts are skipped.
+    template<typename Excluded = KnnKeepAll>
+    size_t nearest(const Point& query, size_t k, Neighbor* best, const Excluded& excluded = {}) const {
+        size_t found = 0;
+        if (k == 0 || nodes.empty()) return 0;
+        search(0, toFeatures(query), k, best, found, excluded);
+        return found;
+    }
+
+    // Offers this index's points to a best list already holding found entries, to merge the neighbours of several
+    // indexes (ids are only meaningful within their own index)
+    template<typename Excluded = KnnKeepAll>
+    void offerNearest(const Point& query, size_t k, Neighbor* best, size_t& found, const Excluded& excluded = {}) const {
+        if (k == 0 || nodes.empty()) return;
+        search(0, toFeatures(query), k, best, found, excluded);
+    }
+
+    // nearest() for count queries: best holds k slots per query and found receives each query's count. Queries are
+    // answered grouped by the leaf they fall into, so queries sharing a neighbourhood (consecutive time steps, a fleet
+    // of similar machines) reuse the leaves and boxes the previous query left in cache.
+    template<typename Excluded = KnnKeepAll>
+    void nearestBatch(const Point* queries, size_t count, size_t k, Neighbor* best, size_t* found, const Excluded& excluded = {}) const {
+        std::fill(found, found + count, 0);
+        if (k == 0 || nodes.empty()) return;
+        std::vector<std::pair<int, uint32_t>> order(count);  // (home leaf, query)
+        std::vector<Features> features(count);
+        for (size_t i = 0; i < count; ++i) {
+            features[i] = toFeatures(queries[i]);
+            int nodeIndex = 0;
+            while (nodes[nodeIndex].left >= 0) {
+                const Node& node = nodes[nodeIndex];
+                nodeIndex = features[i][node.axis] < node.split ? node.left : node.right;
+            }
+            order[i] = {nodeIndex, static_cast<uint32_t>(i)};
+        }
+        std::sort(order.begin(), order.end());
+        for (const auto& [leaf, query] : order) search(0, features[query], k, best + query * k, found[query], excluded);
+    }
+};
+
+#endif // KNN_INDEX_HPP
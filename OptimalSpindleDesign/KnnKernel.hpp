@@ -0,0 +1,174 @@
+#ifndef KNN_KERNEL_HPP
+#define KNN_KERNEL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Brute-force k-nearest-neighbour kernel over pre-scaled float32 features stored column-wise. Distances are computed
+// a fixed-width group of points at a time, with one pass per feature over a contiguous column, so the compiler turns
+// each pass into full-width SIMD arithmetic (16 floats per AVX-512 instruction, 8 per AVX) with no scalar tail. The
+// k best candidates stay in a small sorted array on the caller's stack.
+
+struct KnnNeighbor {
+    float distance = std::numeric_limits<float>::infinity();  // Squared Euclidean distance
+    int label = 0;
+    uint32_t id = 0;
+};
+
+// Ties on distance go to the lower label, as a sort of (distance, label) pairs would order them
+inline bool closerNeighbor(const KnnNeighbor& a, const KnnNeighbor& b) {
+    return a.distance < b.distance || (a.distance == b.distance && a.label < b.label);
+}
+
+// Offers candidate to the sorted best list holding found of at most k entries; k is small, so insertion is linear
+inline void offerNeighbor(const KnnNeighbor& candidate, size_t k, KnnNeighbor* best, size_t& found) {
+    if (found == k && !closerNeighbor(candidate, best[k - 1])) return;
+    size_t slot = found < k ? found++ : k - 1;
+    while (slot > 0 && closerNeighbor(candidate, best[slot - 1])) {
+        best[slot] = best[slot - 1];
+        --slot;
+    }
+    best[slot] = candidate;
+}
+
+// Exclusion predicate of the neighbour searches that excludes nothing; a search skips every id its predicate accepts
+struct KnnKeepAll {
+    bool operator()(uint32_t) const { return false; }
+};
+
+// Points per distance group; columns are padded to whole groups
+inline constexpr size_t knnGroupWidth = 16;
+
+// Squared distances from query to the group of points starting at first of each column; Columns holds either
+// vectors or raw pointers. Padding slots get meaningless values.
+template<size_t Dimensions, typename Columns>
+inline void knnGroupDistances(const Columns& columns, const std::array<float, Dimensions>& query, size_t first,
+                              float (&distances)[knnGroupWidth]) {
+    for (size_t j = 0; j < knnGroupWidth; ++j) distances[j] = 0.0f;
+    for (size_t d = 0; d < Dimensions; ++d) {
+        const float* column = &columns[d][0] + first;
+        const float value = query[d];
+        for (size_t j = 0; j < knnGroupWidth; ++j) {
+            float difference = column[j] - value;
+            distances[j] += difference * difference;
+        }
+    }
+}
+
+template<size_t Dimensions>
+class FeatureBlock {
+public:
+    using Features = std::array<float, Dimensions>;
+    static constexpr size_t groupWidth = knnGroupWidth;
+
+private:
+    std::array<std::vector<float>, Dimensions> columns;
+    std::vector<int> labels;
+    std::vector<uint32_t> ids;
+
+public:
+    size_t size() const { return ids.size(); }
+    bool empty() const { return ids.empty(); }
+    uint32_t id(size_t position) const { return ids[position]; }
+    int label(size_t position) const { return labels[position]; }
+    float feature(size_t dimension, size_t position) const { return columns[dimension][position]; }
+
+    Features features(size_t position) const {
+        Features point;
+        for (size_t d = 0; d < Dimensions; ++d) point[d] = columns[d][position];
+        return point;
+    }
+
+    void reserve(size_t capacity) {
+        size_t padded = (capacity + groupWidth - 1) / groupWidth * groupWidth;
+        for (auto& column : columns) column.reserve(padded);
+        labels.reserve(capacity);
+        ids.reserve(capacity);
+    }
+
+    void clear() {
+        for (auto& column : columns) column.clear();
+        labels.clear();
+        ids.clear();
+    }
+
+    void push(const Features& point, int label, uint32_t id) {
+        size_t position = ids.size();
+        if (position == columns[0].size()) {
+            for (auto& column : columns) column.resize(position + groupWidth, 0.0f);
+        }
+        for (size_t d = 0; d < Dimensions; ++d) columns[d][position] = point[d];
+        labels.push_back(label);
+        ids.push_back(id);
+    }
+
+    // Moves the last point into position; order is not preserved
+    void erase(size_t position) {
+        size_t last = ids.size() - 1;
+        for (auto& column : columns) column[position] = column[last];
+        labels[position] = labels[last];
+        ids[position] = ids[last];
+        labels.pop_back();
+        ids.pop_back();
+    }
+
+    // Squared distances from query to the group of points starting at first; padding slots get meaningless values
+    void groupDistances(const Features& query, size_t first, float (&distances)[groupWidth]) const {
+        knnGroupDistances<Dimensions>(columns, query, first, distances);
+    }
+
+    // Offers every point of the block that excluded does not reject to the best list (see offerNeighbor)
+    template<typename Excluded = KnnKeepAll>
+    void nearest(const Features& query, size_t k, KnnNeighbor* best, size_t& found, const Excluded& excluded = {}) const {
+        float distances[groupWidth];
+        for (size_t first = 0; first < ids.size(); first += groupWidth) {
+            groupDistances(query, first, distances);
+            offerGroup(distances, first, k, best, found, excluded);
+        }
+    }
+
+private:
+    template<typename Excluded>
+    void offerGroup(const float (&distances)[groupWidth], size_t first, size_t k, KnnNeighbor* best, size_t& found,
+                    const Excluded& excluded) const {
+        size_t count = std::min(groupWidth, ids.size() - first);
+        for (size_t j = 0; j < count; ++j) {
+            // Cheap reject before building the candidate; equal distances may still win on label
+            if (found == k && distances[j] > best[k - 1].distance) continue;
+            if (excluded(ids[first + j])) continue;
+            offerNeighbor({distances[j], labels[first + j], ids[first + j]}, k, best, found);
+        }
+    }
+};
+
+// Non-owning view of points laid out like a FeatureBlock but stored elsewhere, such as a memory-mapped file. The ids
+// are implicit: point i has id firstId + i. Every column must stay readable for a whole group past the last point.
+template<size_t Dimensions>
+struct FeatureColumns {
+    using Features = std::array<float, Dimensions>;
+    static constexpr size_t groupWidth = knnGroupWidth;
+
+    std::array<const float*, Dimensions> columns{};
+    const int32_t* labels = nullptr;
+    size_t size = 0;
+    uint32_t firstId = 0;
+
+    // Offers every point to the best list (see offerNeighbor)
+    void nearest(const Features& query, size_t k, KnnNeighbor* best, size_t& found) const {
+        float distances[groupWidth];
+        for (size_t first = 0; first < size; first += groupWidth) {
+            knnGroupDistances<Dimensions>(columns, query, first, distances);
+            size_t count = std::min(groupWidth, size - first);
+            for (size_t j = 0; j < count; ++j) {
+                if (found == k && distances[j] > best[k - 1].distance) continue;
+                offerNeighbor({distances[j], labels[first + j], firstId + static_cast<uint32_t>(first + j)}, k, best, found);
+            }
+        }
+    }
+};
+
+#endif // KNN_KERNEL_HPP
@@ -0,0 +1,117 @@
+#include "Logger.hpp"
+#include <cstdio>
+
+const char* logLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info: return "INFO";
+        case LogLevel::Warning: return "WARN";
+        case LogLevel::Error: return "ERROR";
+        default: return "OFF";
+    }
+}
+
+Logger::Logger(const std::string& path, LogLevel level, std::size_t capacity, std::chrono::milliseconds flushInterval)
+    : mask(0), enqueuePosition(0), dequeuePosition(0), writtenCount(0), droppedCount(0), minimumLevel(level),
+      file(path, std::ios::app), opened(Clock::now()), stopping(false), flushRequested(false), flushInterval(flushInterval) {
+    // Slot indices wrap with a mask, so the capacity is rounded up to a power of two
+    std::size_t size = 2;
+    while (size < capacity) size <<= 1;
+    mask = size - 1;
+    slots = std::make_unique<Slot[]>(size);
+    for (std::size_t i = 0; i < size; ++i) slots[i].sequence.store(i, std::memory_order_relaxed);
+    writer = std::thread([this]() { writerLoop(); });
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping.store(true);
+    }
+    wake.notify_one();
+    if (writer.joinable()) writer.join();
+}
+
+bool Logger::push(LogLevel level, const LogLine& line) {
+    std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &slots[position & mask];
+        std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+        if (difference == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+        } else if (difference < 0) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+    std::string_view text = line.view();
+    slot->record.level = level;
+    slot->record.time = Clock::now();
+    slot->record.length = text.size();
+    std::memcpy(slot->record.text, text.data(), text.size());
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool Logger::pop(Record& record) {
+    Slot& slot = slots[dequeuePosition & mask];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) return false;
+    record = slot.record;
+    slot.sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+    ++dequeuePosition;
+    return true;
+}
+
+void Logger::flush() {
+    std::size_t target = enqueuePosition.load(std::memory_order_acquire);
+    while (writtenCount.load(std::memory_order_acquire) < target) {
+        flushRequested.store(true);
+        wake.notify_one();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void Logger::writerLoop() {
+    std::string batch;
+    Record record;
+    std::size_t reportedDrops = 0;
+    while (true) {
+        bool finalPass = stopping.load();
+        flushRequested.store(false);
+        batch.clear();
+        std::size_t count = 0;
+        while (pop(record)) {
+            // Elapsed seconds since the logger opened, then the level
+            char prefix[48];
+            int prefixLength = std::snprintf(prefix, sizeof(prefix), "[%10.3f] %-6s",
+                                             std::chrono::duration<double>(record.time - opened).count(), logLevelName(record.level));
+            batch.append(prefix, static_cast<std::size_t>(prefixLength));
+            batch.append(record.text, record.length);
+            batch += '\n';
+            ++count;
+        }
+        std::size_t drops = droppedCount.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            batch += "Logger dropped " + std::to_string(drops - reportedDrops) + " records (queue full)\n";
+            reportedDrops = drops;
+        }
+        if (!batch.empty()) {
+            file.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            file.flush();
+        }
+        writtenCount.fetch_add(count, std::memory_order_release);
+        if (finalPass) return;
+        if (count > 0) continue;
+        if (enqueuePosition.load(std::memory_order_relaxed) != dequeuePosition) {
+            // A producer has claimed the next slot but not filled it yet
+            std::this_thread::yield();
+        } else {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait_for(lock, flushInterval, [this]() { return stopping.load() || flushRequested.load(); });
+        }
+    }
+}
@@ -0,0 +1,158 @@
+#ifndef LOGGER_HPP
+#define LOGGER_HPP
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+enum class LogLevel {
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Off
+};
+
+// Statements below this level compile away; build with -DSPINDLE_LOG_LEVEL=0 to keep debug logging
+#ifndef SPINDLE_LOG_LEVEL
+#define SPINDLE_LOG_LEVEL 1
+#endif
+inline constexpr LogLevel compiledLogLevel = static_cast<LogLevel>(SPINDLE_LOG_LEVEL);
+
+const char* logLevelName(LogLevel level);
+
+// Fixed-size message formatted on the caller's stack; longer messages are truncated
+class LogLine {
+public:
+    static constexpr std::size_t capacity = 480;
+
+private:
+    char text[capacity];
+    std::size_t length = 0;
+
+    void append(const char* data, std::size_t size) {
+        std::size_t count = size < capacity - length ? size : capacity - length;
+        std::memcpy(text + length, data, count);
+        length += count;
+    }
+
+public:
+    LogLine& operator<<(std::string_view value) {
+        append(value.data(), value.size());
+        return *this;
+    }
+    LogLine& operator<<(const char* value) { return *this << std::string_view(value); }
+    LogLine& operator<<(const std::string& value) { return *this << std::string_view(value); }
+    LogLine& operator<<(char value) {
+        append(&value, 1);
+        return *this;
+    }
+
+    // Numbers print like a default-formatted ostream (six significant digits for floating point)
+    template<typename T>
+        requires (std::is_arithmetic_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, bool>)
+    LogLine& operator<<(T value) {
+        char buffer[32];
+        std::to_chars_result result;
+        if constexpr (std::is_floating_point_v<T>) {
+            result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::general, 6);
+        } else {
+            result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        }
+        append(buffer, static_cast<std::size_t>(result.ptr - buffer));
+        return *this;
+    }
+
+    std::string_view view() const { return std::string_view(text, length); }
+};
+
+// Asynchronous file logger. Producers claim slots of a bounded lock-free ring (Vyukov's MPSC scheme) and never
+// block; a background thread drains it and writes each batch with one write and one flush. A full ring drops the
+// record and counts it rather than stalling the caller.
+class Logger {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct Record {
+        LogLevel level = LogLevel::Info;
+        Clock::time_point time;
+        std::size_t length = 0;
+        char text[LogLine::capacity];
+    };
+
+    struct Slot {
+        std::atomic<std::size_t> sequence{0};
+        Record record;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t mask;
+    alignas(64) std::atomic<std::size_t> enqueuePosition;
+    alignas(64) std::size_t dequeuePosition;    // Writer thread only
+    std::atomic<std::size_t> writtenCount;
+    std::atomic<std::size_t> droppedCount;
+    std::atomic<LogLevel> minimumLevel;
+
+    std::ofstream file;
+    Clock::time_point opened;
+    std::thread writer;
+    std::mutex wakeMutex;                       // Guards the writer's sleep only; producers never take it
+    std::condition_variable wake;
+    std::atomic<bool> stopping;
+    std::atomic<bool> flushRequested;
+    std::chrono::milliseconds flushInterval;
+
+    bool pop(Record& record);
+    void writerLoop();
+
+public:
+    explicit Logger(const std::string& path, LogLevel level = LogLevel::Info, std::size_t capacity = 1024,
+                    std::chrono::milliseconds flushInterval = std::chrono::milliseconds(20));
+    ~Logger();   // Writes everything still queued
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    void setLevel(LogLevel level) { minimumLevel.store(level, std::memory_order_relaxed); }
+    bool enabled(LogLevel level) const {
+        return level >= compiledLogLevel && level >= minimumLevel.load(std::memory_order_relaxed);
+    }
+
+    // Returns false when the ring is full and the record was dropped
+    bool push(LogLevel level, const LogLine& line);
+    // Blocks until every record pushed before the call is on disk
+    void flush();
+
+    std::size_t dropped() const { return droppedCount.load(std::memory_order_relaxed); }
+};
+
+// The message expression is only evaluated when the level is compiled in and enabled at run time:
+// SPINDLE_LOG_DEBUG(log, "Selected parents " << first << " and " << second);
+#define SPINDLE_LOG(logger, level, message)                  \
+    do {                                                      \
+        if constexpr ((level) >= compiledLogLevel) {          \
+            if ((logger).enabled(level)) {                    \
+                LogLine spindleLogLine;                       \
+                spindleLogLine << message;                    \
+                (logger).push((level), spindleLogLine);       \
+            }                                                 \
+        }                                                     \
+    } while (false)
+
+#define SPINDLE_LOG_DEBUG(logger, message) SPINDLE_LOG(logger, LogLevel::Debug, message)
+#define SPINDLE_LOG_INFO(logger, message) SPINDLE_LOG(logger, LogLevel::Info, message)
+#define SPINDLE_LOG_WARNING(logger, message) SPINDLE_LOG(logger, LogLevel::Warning, message)
+#define SPINDLE_LOG_ERROR(logger, message) SPINDLE_LOG(logger, LogLevel::Error, message)
+
+#endif // LOGGER_HPP
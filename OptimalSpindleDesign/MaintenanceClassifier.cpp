@@ -0,0 +1,329 @@
+#include "MaintenanceClassifier.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+constexpr size_t featureCount = MaintenanceClassifier::featureCount;
+
+struct TrainingSet {
+    std::array<std::vector<double>, featureCount> columns;
+    std::vector<double> labels;  // 0 or 1
+    size_t size() const { return labels.size(); }
+};
+
+// Runs task(first, last) over [0, count) in chunks on the shared executor; returns the chunk results in order
+template<typename Task>
+auto forEachChunk(size_t count, size_t chunkSize, const Task& task) {
+    using Result = decltype(task(size_t(0), size_t(0)));
+    ThreadPool& executor = ThreadPool::shared();
+    std::vector<std::future<Result>> pending;
+    for (size_t first = 0; first < count; first += chunkSize) {
+        size_t last = std::min(count, first + chunkSize);
+        pending.push_back(executor.submit([&task, first, last]() { return task(first, last); }));
+    }
+    std::vector<Result> results;
+    results.reserve(pending.size());
+    try {
+        for (auto& result : pending) results.push_back(executor.wait(result));
+    } catch (...) {
+        // Tasks still in flight reference task and the training data
+        for (auto& result : pending) {
+            if (result.valid()) result.wait();
+        }
+        throw;
+    }
+    return results;
+}
+
+double sigmoid(double score) { return 1.0 / (1.0 + std::exp(-score)); }
+
+// Solves the symmetric positive definite system matrix * x = vector in place by Cholesky decomposition
+template<size_t N>
+void solveSymmetric(std::array<double, N * N>& matrix, std::array<double, N>& vector) {
+    for (size_t j = 0; j < N; ++j) {
+        double diagonal = matrix[j * N + j];
+        for (size_t k = 0; k < j; ++k) diagonal -= matrix[j * N + k] * matrix[j * N + k];
+        diagonal = std::sqrt(std::max(diagonal, 1e-300));
+        matrix[j * N + j] = diagonal;
+        for (size_t i = j + 1; i < N; ++i) {
+            double sum = matrix[i * N + j];
+            for (size_t k = 0; k < j; ++k) sum -= matrix[i * N + k] * matrix[j * N + k];
+            matrix[i * N + j] = sum / diagonal;
+        }
+    }
+    for (size_t i = 0; i < N; ++i) {
+        for (size_t k = 0; k < i; ++k) vector[i] -= matrix[i * N + k] * vector[k];
+        vector[i] /= matrix[i * N + i];
+    }
+    for (size_t i = N; i-- > 0;) {
+        for (size_t k = i + 1; k < N; ++k) vector[i] -= matrix[k * N + i] * vector[k];
+        vector[i] /= matrix[i * N + i];
+    }
+}
+
+void fitLogistic(const TrainingSet& data, const ClassifierSettings& settings, MaintenanceClassifier::Features& weights, double& bias) {
+    constexpr size_t terms = featureCount + 1;  // Intercept first
+    const size_t n = data.size();
+    std::array<double, featureCount> mean{};
+    std::array<double, featureCount> scale{};
+    for (size_t f = 0; f < featureCount; ++f) {
+        for (double value : data.columns[f]) mean[f] += value;
+        mean[f] /= n;
+        for (double value : data.columns[f]) scale[f] += (value - mean[f]) * (value - mean[f]);
+        scale[f] = std::sqrt(scale[f] / n);
+        if (scale[f] == 0.0) scale[f] = 1.0;  // A constant feature gets no weight anyway
+    }
+
+    struct Moments {
+        std::array<double, terms> gradient{};
+        std::array<double, terms * terms> hessian{};  // Lower triangle
+    };
+    std::array<double, terms> beta{};
+    for (int iteration = 0; iteration < settings.newtonIterations; ++iteration) {
+        std::vector<Moments> parts = forEachChunk(n, settings.chunkSize, [&](size_t first, size_t last) {
+            Moments moments;
+            std::array<double, terms> z;
+            z[0] = 1.0;
+            for (size_t i = first; i < last; ++i) {
+                double score = beta[0];
+                for (size_t f = 0; f < featureCount; ++f) {
+                    z[f + 1] = (data.columns[f][i] - mean[f]) / scale[f];
+                    score += beta[f + 1] * z[f + 1];
+                }
+                double p = sigmoid(score);
+                double residual = p - data.labels[i];
+                double curvature = p * (1.0 - p);
+                for (size_t a = 0; a < terms; ++a) {
+                    moments.gradient[a] += residual * z[a];
+                    for (size_t b = 0; b <= a; ++b) moments.hessian[a * terms + b] += curvature * z[a] * z[b];
+                }
+            }
+            return moments;
+        });
+        Moments total;
+        for (const Moments& part : parts) {
+            for (size_t a = 0; a < terms; ++a) total.gradient[a] += part.gradient[a];
+            for (size_t a = 0; a < terms * terms; ++a) total.hessian[a] += part.hessian[a];
+        }
+        // The ridge keeps separable records from driving the weights to infinity
+        for (size_t a = 0; a < terms; ++a) {
+            double penalty = a == 0 ? 1e-9 * n : settings.ridge * n;
+            total.gradient[a] += a == 0 ? 0.0 : penalty * beta[a];
+            total.hessian[a * terms + a] += penalty;
+        }
+        solveSymmetric<terms>(total.hessian, total.gradient);
+        double step = 0.0;
+        for (size_t a = 0; a < terms; ++a) {
+            beta[a] -= total.gradient[a];
+            step = std::max(step, std::abs(total.gradient[a]));
+        }
+        if (step < 1e-10) break;
+    }
+
+    bias = beta[0];
+    for (size_t f = 0; f < featureCount; ++f) {
+        weights[f] = beta[f + 1] / scale[f];
+        bias -= weights[f] * mean[f];
+    }
+}
+
+// Candidate thresholds of one feature: distinct quantiles of at most 65536 evenly strided training values
+std::vector<double> quantileThresholds(const std::vector<double>& column, int bins) {
+    size_t stride = std::max<size_t>(1, column.size() / 65536);
+    std::vector<double> sample;
+    for (size_t i = 0; i < column.size(); i += stride) sample.push_back(column[i]);
+    std::sort(sample.begin(), sample.end());
+    std::vector<double> thresholds;
+    for (int j = 1; j < bins; ++j) {
+        double value = sample[std::min(sample.size() - 1, sample.size() * j / bins)];
+        // A threshold at the largest value would send every record left
+        if (value < sample.back() && (thresholds.empty() || value > thresholds.back())) thresholds.push_back(value);
+    }
+    return thresholds;
+}
+
+void fitBoostedTrees(const TrainingSet& data, const ClassifierSettings& settings, size_t& treeCount, size_t& depth,
+                     std::vector<uint8_t>& splitFeatures, std::vector<double>& splitThresholds, std::vector<double>& leafValues,
+                     double& bias) {
+    const size_t n = data.size();
+    const size_t bins = static_cast<size_t>(settings.bins);
+    depth = static_cast<size_t>(settings.depth);
+    treeCount = static_cast<size_t>(settings.trees);
+    const size_t leafCount = size_t(1) << depth;
+
+    // Bin b of a feature holds the values above b thresholds, so value > threshold j exactly when bin > j
+    std::array<std::vector<double>, featureCount> thresholds;
+    std::array<std::vector<uint8_t>, featureCount> binned;
+    for (size_t f = 0; f < featureCount; ++f) {
+        thresholds[f] = quantileThresholds(data.columns[f], settings.bins);
+        binned[f].resize(n);
+    }
+    forEachChunk(n, settings.chunkSize, [&](size_t first, size_t last) {
+        for (size_t f = 0; f < featureCount; ++f) {
+            for (size_t i = first; i < last; ++i) {
+                auto position = std::lower_bound(thresholds[f].begin(), thresholds[f].end(), data.columns[f][i]);
+                binned[f][i] = static_cast<uint8_t>(position - thresholds[f].begin());
+            }
+        }
+        return 0;
+    });
+
+    double positives = 0.0;
+    for (double label : data.labels) positives += label;
+    double prior = std::clamp(positives / n, 1e-6, 1.0 - 1e-6);
+    bias = std::log(prior / (1.0 - prior));
+    std::vector<double> scores(n, bias);
+    std::vector<double> gradients(n);
+    std::vector<double> curvatures(n);
+    std::vector<uint8_t> leafOf(n);
+    splitFeatures.clear();
+    splitThresholds.clear();
+    leafValues.clear();
+
+    for (size_t tree = 0; tree < treeCount; ++tree) {
+        forEachChunk(n, settings.chunkSize, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                double p = sigmoid(scores[i]);
+                gradients[i] = p - data.labels[i];
+                curvatures[i] = std::max(p * (1.0 - p), 1e-12);
+                leafOf[i] = 0;
+            }
+            return 0;
+        });
+
+        for (size_t level = 0; level < depth; ++level) {
+            // Gradient and curvature sums per (current leaf, feature, bin)
+            const size_t nodes = size_t(1) << level;
+            const size_t cells = nodes * featureCount * bins;
+            std::vector<std::vector<double>> parts = forEachChunk(n, settings.chunkSize, [&](size_t first, size_t last) {
+                std::vector<double> histogram(2 * cells, 0.0);
+                for (size_t i = first; i < last; ++i) {
+                    size_t base = leafOf[i] * featureCount * bins;
+                    for (size_t f = 0; f < featureCount; ++f) {
+                        size_t cell = base + f * bins + binned[f][i];
+                        histogram[2 * cell] += gradients[i];
+                        histogram[2 * cell + 1] += curvatures[i];
+                    }
+                }
+                return histogram;
+            });
+            std::vector<double> histogram(2 * cells, 0.0);
+            for (const auto& part : parts) {
+                for (size_t c = 0; c < histogram.size(); ++c) histogram[c] += part[c];
+            }
+
+            // The same split applies to every node of the level, so its gain is summed over them
+            double bestGain = -std::numeric_limits<double>::infinity();
+            size_t bestFeature = 0;
+            size_t bestBin = bins;
+            double lambda = settings.leafRidge;
+            for (size_t f = 0; f < featureCount; ++f) {
+                for (size_t j = 0; j < thresholds[f].size(); ++j) {
+                    double gain = 0.0;
+                    for (size_t node = 0; node < nodes; ++node) {
+                        const double* cell = histogram.data() + 2 * (node * featureCount + f) * bins;
+                        double leftGradient = 0.0, leftCurvature = 0.0, gradient = 0.0, curvature = 0.0;
+                        for (size_t b = 0; b < bins; ++b) {
+                            if (b <= j) {
+                                leftGradient += cell[2 * b];
+                                leftCurvature += cell[2 * b + 1];
+                            }
+                            gradient += cell[2 * b];
+                            curvature += cell[2 * b + 1];
+                        }
+                        double rightGradient = gradient - leftGradient;
+                        double rightCurvature = curvature - leftCurvature;
+                        gain += leftGradient * leftGradient / (leftCurvature + lambda) +
+                                rightGradient * rightGradient / (rightCurvature + lambda);
+                    }
+                    if (gain > bestGain) {
+                        bestGain = gain;
+                        bestFeature = f;
+                        bestBin = j;
+                    }
+                }
+            }
+            // Every feature constant: a split nothing passes, so the level changes no leaf
+            bool constant = bestBin == bins;
+            splitFeatures.push_back(static_cast<uint8_t>(bestFeature));
+            splitThresholds.push_back(constant ? std::numeric_limits<double>::infinity() : thresholds[bestFeature][bestBin]);
+            if (constant) continue;
+            forEachChunk(n, settings.chunkSize, [&](size_t first, size_t last) {
+                for (size_t i = first; i < last; ++i) leafOf[i] |= static_cast<uint8_t>((binned[bestFeature][i] > bestBin) << level);
+                return 0;
+            });
+        }
+
+        std::vector<std::vector<double>> sums = forEachChunk(n, settings.chunkSize, [&](size_t first, size_t last) {
+            std::vector<double> leafSums(2 * leafCount, 0.0);
+            for (size_t i = first; i < last; ++i) {
+                leafSums[2 * leafOf[i]] += gradients[i];
+                leafSums[2 * leafOf[i] + 1] += curvatures[i];
+            }
+            return leafSums;
+        });
+        std::vector<double> values(leafCount, 0.0);
+        for (size_t leaf = 0; leaf < leafCount; ++leaf) {
+            double gradient = 0.0, curvature = 0.0;
+            for (const auto& part : sums) {
+                gradient += part[2 * leaf];
+                curvature += part[2 * leaf + 1];
+            }
+            values[leaf] = -settings.learningRate * gradient / (curvature + settings.leafRidge);
+            leafValues.push_back(values[leaf]);
+        }
+        // Each record's score advances by the value of the leaf it fell into, the same value prediction adds
+        forEachChunk(n, settings.chunkSize, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) scores[i] += leafValues[tree * leafCount + leafOf[i]];
+            return 0;
+        });
+    }
+}
+} // namespace
+
+MaintenanceClassifier trainMaintenanceClassifier(std::span<const MaintenanceRecord> records, const ClassifierSettings& settings) {
+    if (records.empty()) throw std::invalid_argument("A classifier needs at least one training record");
+    if (settings.model == MaintenanceModel::Neighbors) throw std::invalid_argument("Nearest-neighbour prediction needs no training");
+    if (settings.chunkSize == 0) throw std::invalid_argument("Chunk size must be positive");
+    if (settings.model == MaintenanceModel::Logistic && (settings.newtonIterations < 1 || settings.ridge < 0.0)) {
+        throw std::invalid_argument("Logistic regression needs at least one iteration and a non-negative ridge");
+    }
+    if (settings.model == MaintenanceModel::BoostedTrees &&
+        (settings.trees < 1 || settings.depth < 1 || settings.depth > 8 || settings.bins < 2 || settings.bins > 255 ||
+         settings.learningRate <= 0.0 || settings.leafRidge < 0.0)) {
+        throw std::invalid_argument("Boosted trees need at least one tree, depth 1-8, 2-255 bins and a positive learning rate");
+    }
+
+    TrainingSet data;
+    for (auto& column : data.columns) column.resize(records.size());
+    data.labels.resize(records.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+        MaintenanceClassifier::Features x = MaintenanceClassifier::features(records[i]);
+        for (size_t f = 0; f < featureCount; ++f) data.columns[f][i] = x[f];
+        data.labels[i] = records[i].label != 0 ? 1.0 : 0.0;
+    }
+
+    MaintenanceClassifier model;
+    model.kind = settings.model;
+    if (settings.model == MaintenanceModel::Logistic) {
+        fitLogistic(data, settings, model.weights, model.bias);
+    } else {
+        fitBoostedTrees(data, settings, model.treeCount, model.depth, model.splitFeatures, model.splitThresholds,
+                        model.leafValues, model.bias);
+    }
+
+    std::vector<size_t> correct = forEachChunk(records.size(), settings.chunkSize, [&](size_t first, size_t last) {
+        size_t count = 0;
+        for (size_t i = first; i < last; ++i) count += model.predict(records[i]) == (records[i].label != 0 ? 1 : 0);
+        return count;
+    });
+    model.records = records.size();
+    model.accuracy = static_cast<double>(std::accumulate(correct.begin(), correct.end(), size_t(0))) / records.size();
+    return model;
+}
@@ -0,0 +1,127 @@
+#ifndef MAINTENANCE_CLASSIFIER_HPP
+#define MAINTENANCE_CLASSIFIER_HPP
+
+#include "MaintenanceHistory.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+enum class MaintenanceModel {
+    Neighbors,     // Majority of the three nearest history records; follows every append
+    Logistic,      // Logistic regression over the six features
+    BoostedTrees   // Gradient-boosted oblivious decision trees
+};
+
+struct ClassifierSettings {
+    MaintenanceModel model = MaintenanceModel::BoostedTrees;
+    // Logistic regression is fitted by Newton's method on standardized features
+    int newtonIterations = 25;
+    double ridge = 1e-4;        // L2 penalty per record on the standardized weights
+    // Boosted trees minimize log loss with second-order leaf values
+    int trees = 100;
+    int depth = 4;              // Levels per tree, 1 to 8
+    double learningRate = 0.2;  // Shrinkage of each tree's leaf values
+    int bins = 64;              // Candidate thresholds per feature, at quantiles of the training records (2 to 255)
+    double leafRidge = 1.0;     // L2 penalty on leaf values
+    size_t chunkSize = 16384;   // Records per parallel training task
+};
+
+// A trained maintenance classifier compiled to flat arrays. Logistic regression is one dot product over the raw
+// features, with the standardization folded into its weights. Boosted trees are oblivious: every node on a level
+// tests the same feature against the same threshold, so a tree is depth (feature, threshold) pairs and 2^depth leaf
+// values, and the comparisons on the way down form the leaf index bit by bit with no branches. Either way a prediction
+// costs the same whatever the history size and allocates nothing. Immutable once trained; share it freely.
+class MaintenanceClassifier {
+public:
+    static constexpr size_t featureCount = 6;
+    using Features = std::array<double, featureCount>;
+
+    // Vibration, temperature, load, bearing life, spindle life and wheel wear, in record units
+    static Features features(const MaintenanceRecord& record) {
+        return {record.vibration, record.temperature, record.load, record.bearingLife, record.spindleLife, record.wheelWear};
+    }
+
+    MaintenanceModel model() const { return kind; }
+    size_t trainingRecords() const { return records; }
+    double trainingAccuracy() const { return accuracy; }
+
+    // Log-odds that the record needs maintenance
+    double score(const Features& x) const {
+        if (kind == MaintenanceModel::Logistic) {
+            double sum = bias;
+            for (size_t f = 0; f < featureCount; ++f) sum += weights[f] * x[f];
+            return sum;
+        }
+        double sum = bias;
+        const uint8_t* feature = splitFeatures.data();
+        const double* threshold = splitThresholds.data();
+        const double* leaves = leafValues.data();
+        for (size_t t = 0; t < treeCount; ++t) {
+            size_t leaf = 0;
+            for (size_t level = 0; level < depth; ++level) leaf |= static_cast<size_t>(x[feature[level]] > threshold[level]) << level;
+            sum += leaves[leaf];
+            feature += depth;
+            threshold += depth;
+            leaves += size_t(1) << depth;
+        }
+        return sum;
+    }
+
+    int predict(const MaintenanceRecord& record) const { return score(features(record)) > 0.0 ? 1 : 0; }
+
+    // predict() for many records. Trees are evaluated tree by tree over blocks of queries held column-wise on the
+    // stack, so each level's comparison runs across the whole block in SIMD.
+    void predictBatch(std::span<const MaintenanceRecord> queries, int* labels) const {
+        if (kind == MaintenanceModel::Logistic) {
+            for (size_t i = 0; i < queries.size(); ++i) labels[i] = predict(queries[i]);
+            return;
+        }
+        constexpr size_t block = 64;
+        std::array<std::array<double, block>, featureCount> columns{};
+        std::array<double, block> sums;
+        std::array<uint32_t, block> leaf;
+        for (size_t first = 0; first < queries.size(); first += block) {
+            size_t count = std::min(block, queries.size() - first);
+            for (size_t q = 0; q < count; ++q) {
+                Features x = features(queries[first + q]);
+                for (size_t f = 0; f < featureCount; ++f) columns[f][q] = x[f];
+            }
+            sums.fill(bias);
+            for (size_t t = 0; t < treeCount; ++t) {
+                leaf.fill(0);
+                for (size_t level = 0; level < depth; ++level) {
+                    const double* column = columns[splitFeatures[t * depth + level]].data();
+                    double threshold = splitThresholds[t * depth + level];
+                    for (size_t q = 0; q < block; ++q) leaf[q] |= static_cast<uint32_t>(column[q] > threshold) << level;
+                }
+                const double* leaves = leafValues.data() + (t << depth);
+                for (size_t q = 0; q < block; ++q) sums[q] += leaves[leaf[q]];
+            }
+            for (size_t q = 0; q < count; ++q) labels[first + q] = sums[q] > 0.0 ? 1 : 0;
+        }
+    }
+
+private:
+    friend MaintenanceClassifier trainMaintenanceClassifier(std::span<const MaintenanceRecord>, const ClassifierSettings&);
+
+    MaintenanceModel kind = MaintenanceModel::Logistic;
+    double bias = 0.0;
+    Features weights{};                   // Logistic only
+    size_t treeCount = 0;                 // Boosted trees only, from here on
+    size_t depth = 0;
+    std::vector<uint8_t> splitFeatures;   // depth per tree, root level first
+    std::vector<double> splitThresholds;  // Tested as feature > threshold, setting that level's bit of the leaf index
+    std::vector<double> leafValues;       // 2^depth per tree
+    size_t records = 0;
+    double accuracy = 0.0;
+};
+
+// Fits settings.model (Logistic or BoostedTrees) to the records. The passes over the records run in chunks on the
+// shared executor. Throws std::invalid_argument if there are no records, the model is Neighbors, or a setting is out
+// of range.
+MaintenanceClassifier trainMaintenanceClassifier(std::span<const MaintenanceRecord> records, const ClassifierSettings& settings);
+
+#endif // MAINTENANCE_CLASSIFIER_HPP
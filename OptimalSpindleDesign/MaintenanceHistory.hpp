@@ -0,0 +1,650 @@
+#ifndef MAINTENANCE_HISTORY_HPP
+#define MAINTENANCE_HISTORY_HPP
+
+#include "FeatureNormalizer.hpp"
+#include "HistoryStore.hpp"
+#include "HnswIndex.hpp"
+#include "KnnIndex.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// One observed operating state and whether it needed maintenance
+struct MaintenanceRecord {
+    double vibration;
+    double temperature;
+    double load;
+    double bearingLife;
+    double spindleLife;
+    double wheelWear;
+    int label; // 1 = maintenance needed, 0 = no maintenance
+    MaintenanceRecord(double vib, double temp, double ld, double bLife, double sLife, double wWear, int lbl)
+        : vibration(vib), temperature(temp), load(ld), bearingLife(bLife), spindleLife(sLife), wheelWear(wWear), label(lbl) {}
+};
+
+using MaintenanceIndex = HistoryStore::Index;
+using MaintenanceGraph = HnswIndex<HistoryStore::dimensions>;
+
+using MaintenanceTransform = FeatureTransform<HistoryStore::dimensions>;
+using MaintenanceNormalizer = FeatureNormalizer<HistoryStore::dimensions>;
+
+// Vibration, temperature, load, bearing life, spindle life and wheel wear, in record units
+inline MaintenanceTransform::Values maintenanceValues(const MaintenanceRecord& record) {
+    return {record.vibration, record.temperature, record.load, record.bearingLife, record.spindleLife, record.wheelWear};
+}
+
+// Each feature divided by its typical operating range in the synthetic history. A persistent store keeps its features
+// under this transform; an in-memory history starts from it until it has seen enough records to learn its own.
+inline const MaintenanceTransform& fixedMaintenanceTransform() {
+    static const MaintenanceTransform transform = MaintenanceTransform::ranges({2.0, 30.0, 1500.0, 50000.0, 1.0, 40.0});
+    return transform;
+}
+
+// Features normalized so each contributes comparably to the kNN distance
+inline MaintenanceIndex::Point maintenanceFeatures(const MaintenanceRecord& record,
+                                                   const MaintenanceTransform& transform = fixedMaintenanceTransform()) {
+    return transform.apply(maintenanceValues(record));
+}
+
+// Inverse of maintenanceFeatures for records read back from an index or store, which keeps only float32 features
+inline MaintenanceRecord maintenanceRecord(const HistoryStore::StoredPoint& point,
+                                           const MaintenanceTransform& transform = fixedMaintenanceTransform()) {
+    MaintenanceTransform::Values normalized;
+    for (size_t d = 0; d < HistoryStore::dimensions; ++d) normalized[d] = point.features[d];
+    MaintenanceTransform::Values v = transform.invert(normalized);
+    return MaintenanceRecord(v[0], v[1], v[2], v[3], v[4], v[5], point.label);
+}
+
+enum class RetentionPolicy {
+    Reservoir,      // Uniform sample of every record ever appended
+    ClassBalanced   // Each label keeps up to half the capacity; a full store evicts from the larger class first
+};
+
+enum class NeighborSearch {
+    KdTree,  // Exact
+    Hnsw     // Approximate graph search, for histories too large for exact search to keep up
+};
+
+struct HistoryRetention {
+    size_t capacity = 100000;  // At least 2
+    RetentionPolicy policy = RetentionPolicy::ClassBalanced;
+    // Non-empty: keep every record in a HistoryStore in this directory instead. Capacity and policy then do not
+    // apply; only the records appended since the store's last compaction are held in memory.
+    std::string storeDirectory;
+    size_t compactThreshold = 65536;
+    // Index behind neighbour queries of an in-memory history; a store is always searched exactly
+    NeighborSearch search = NeighborSearch::KdTree;
+    HnswParameters hnsw;
+    // With Hnsw: a graph saved here by saveNeighborIndex() is loaded at construction, restoring the records with it
+    std::string hnswIndexPath;
+    // Normalization of an in-memory history's features, learned from every appended record; a store always uses the
+    // fixed ranges its files were written with. The index is renormalized when a learned scale has moved by more than
+    // rescaleTolerance (relative) since the last renormalization.
+    FeatureScaling scaling = FeatureScaling::Robust;
+    double rescaleTolerance = 0.1;
+};
+
+// Approximate search measured against exact search on the same records
+struct NeighborRecall {
+    size_t queries = 0;
+    size_t k = 0;
+    double recall = 1.0;       // Share of the exact k nearest that the active index also returned
+    double indexMicros = 0.0;  // Mean query time of the active index
+    double exactMicros = 0.0;  // Mean query time of an exact kd-tree over the same records
+};
+
+// Bounded, labelled history behind maintenance prediction. Simulations append while predictions read, and readers
+// never wait for writers: every append publishes a new immutable Version through an atomic shared_ptr, and a query
+// runs against whichever Version it loaded (read-copy-update, with reference counts reclaiming versions no reader
+// holds any more). Writers only serialize among themselves. Once the store is full every append either replaces a
+// record chosen by the retention policy or is dropped, so memory and prediction cost stop growing. Records live in
+// fixed slots. A Version shares a kd-tree over the normalized features of the slots as they were when it was last
+// cut, or an approximate HNSW graph under NeighborSearch::Hnsw. Slots written since then live in immutable delta
+// kd-trees merged geometrically as they grow, plus a small block with the few hundred written since the newest delta,
+// so a publication copies that block, appends cost O(log N) amortized and neighbour queries never scan the history.
+// Features are normalized once, when a slot is written, by the transform the Version carries; queries only
+// apply that transform to themselves. A history given a store directory delegates to the persistent HistoryStore,
+// which synchronizes itself.
+class MaintenanceHistory {
+public:
+    // The in-memory history as of one publication. Queries on it take no lock and see none of the later appends.
+    class Version {
+    private:
+        friend class MaintenanceHistory;
+        using Features = std::array<float, HistoryStore::dimensions>;
+
+        // Slots written since the cut, frozen in an exact index whose entry i holds slots[i]
+        struct Delta {
+            std::vector<uint32_t> slots;  // Sorted
+            MaintenanceIndex index;
+
+            bool holds(uint32_t slot) const { return std::binary_search(slots.begin(), slots.end(), slot); }
+        };
+
+        std::shared_ptr<const MaintenanceIndex> index;  // The slots as of the last cut
+        std::shared_ptr<const MaintenanceGraph> graph;  // Replaces index under NeighborSearch::Hnsw
+        std::vector<std::shared_ptr<const Delta>> deltas; // Oldest first; an entry is stale in every older one and the base
+        std::vector<uint32_t> changed;                  // Slots written since the newest delta, sorted
+        FeatureBlock<HistoryStore::dimensions> recent;  // Current contents of the changed slots
+        MaintenanceTransform transform;                 // Normalization of every point above, and of queries
+        size_t count = 0;
+
+        // Rejects the slots rewritten in deltas from newer on, or in recent
+        struct Stale {
+            const Version* version;
+            size_t newer;
+            bool operator()(uint32_t slot) const {
+                for (size_t i = newer; i < version->deltas.size(); ++i) {
+                    if (version->deltas[i]->holds(slot)) return true;
+                }
+                return std::binary_search(version->changed.begin(), version->changed.end(), slot);
+            }
+        };
+
+        // Stale for the entries of one delta
+        struct StaleEntry {
+            const Version* version;
+            size_t delta;
+            bool operator()(uint32_t entry) const { return Stale{version, delta + 1}(version->deltas[delta]->slots[entry]); }
+        };
+
+        static Features narrow(const MaintenanceIndex::Point& point) {
+            Features features;
+            for (size_t d = 0; d < HistoryStore::dimensions; ++d) features[d] = static_cast<float>(point[d]);
+            return features;
+        }
+
+    public:
+        size_t size() const { return count; }
+        const MaintenanceTransform& featureTransform() const { return transform; }
+
+        // See MaintenanceHistory::nearest
+        size_t nearest(const MaintenanceRecord& query, size_t k, MaintenanceIndex::Neighbor* best) const {
+            if (k == 0) return 0;
+            MaintenanceIndex::Point point = maintenanceFeatures(query, transform);
+            size_t found = 0;
+            if (graph) found = graph->nearest(point, k, best, Stale{this, 0});
+            else index->offerNearest(point, k, best, found, Stale{this, 0});
+            for (size_t i = 0; i < deltas.size(); ++i) deltas[i]->index.offerNearest(point, k, best, found, StaleEntry{this, i});
+            recent.nearest(narrow(point), k, best, found);
+            return found;
+        }
+
+        // See MaintenanceHistory::nearestBatch
+        void nearestBatch(std::span<const MaintenanceRecord> queries, size_t k, MaintenanceIndex::Neighbor* best, size_t* found) const {
+            std::fill(found, found + queries.size(), 0);
+            if (k == 0) return;
+            std::vector<MaintenanceIndex::Point> points(queries.size());
+            for (size_t i = 0; i < queries.size(); ++i) points[i] = maintenanceFeatures(queries[i], transform);
+            if (graph) graph->nearestBatch(points.data(), points.size(), k, best, found, Stale{this, 0});
+            else index->nearestBatch(points.data(), points.size(), k, best, found, Stale{this, 0});
+            for (size_t d = 0; d < deltas.size(); ++d) {
+                for (size_t i = 0; i < points.size(); ++i) {
+                    deltas[d]->index.offerNearest(points[i], k, best + i * k, found[i], StaleEntry{this, d});
+                }
+            }
+            if (recent.empty()) return;
+            for (size_t i = 0; i < points.size(); ++i) recent.nearest(narrow(points[i]), k, best + i * k, found[i]);
+        }
+    };
+
+private:
+    // Slots written since the newest delta that make a publication freeze them into a new delta instead of copying them
+    static constexpr size_t maxRecentSlots = 256;
+    // A new base is cut once the slots written since the last cut reach 1/cutFraction of the history, so each append
+    // pays O(log N) amortized for the deltas and O(cutFraction) for the base; a larger cutFraction keeps the deltas,
+    // which every query also searches, smaller
+    static constexpr size_t cutFraction = 16;
+
+    mutable std::mutex writeMutex;  // Serializes writers and guards everything below except published
+    HistoryRetention retention;
+    std::unique_ptr<HistoryStore> persistent;
+    std::atomic<std::shared_ptr<const Version>> published;  // Null for a persistent history
+    std::vector<MaintenanceRecord> records;         // Slot order, not arrival order
+    std::array<std::vector<uint32_t>, 2> classSlots; // Slots holding each label
+    std::vector<uint32_t> classPosition;            // Index of each slot within its classSlots list
+    std::array<uint64_t, 2> classSeen{};            // Records ever appended per label
+    uint64_t seen = 0;
+    uint64_t evicted = 0;
+    std::mt19937_64 rng;
+    std::vector<uint32_t> changedSlots;             // Slots written since the published base was cut, unordered
+    std::vector<char> slotChanged;                  // Whether each slot is in changedSlots
+    std::vector<uint32_t> recentSlots;              // Slots written since the newest delta, unordered
+    std::vector<char> slotRecent;                   // Whether each slot is in recentSlots
+    std::vector<std::shared_ptr<const Version::Delta>> deltas; // Those of the published version
+    MaintenanceNormalizer normalizer;               // Feature statistics of every record ever appended
+    MaintenanceTransform transform = fixedMaintenanceTransform(); // Normalization of the published base
+    std::vector<MaintenanceIndex::Point> normalized; // Each slot's features under transform, computed as it is written
+
+    // Binary, native-endian sidecar holding the transform a saved graph's features were normalized with
+    static constexpr char scalingMagic[8] = {'S', 'P', 'S', 'C', 'A', 'L', 'E', '1'};
+
+    static std::string scalingPath(const std::string& indexPath) { return indexPath + ".scaling"; }
+
+    static void saveTransform(const MaintenanceTransform& saved, const std::string& path) {
+        std::ofstream file(path, std::ios::binary);
+        file.write(scalingMagic, sizeof(scalingMagic));
+        file.write(reinterpret_cast<const char*>(saved.offset.data()), sizeof(saved.offset));
+        file.write(reinterpret_cast<const char*>(saved.inverseScale.data()), sizeof(saved.inverseScale));
+        if (!file) throw std::runtime_error("Cannot write scaling file: " + path);
+    }
+
+    // Graphs saved without a sidecar were normalized by the fixed ranges
+    static MaintenanceTransform loadTransform(const std::string& path) {
+        if (!std::filesystem::exists(path)) return fixedMaintenanceTransform();
+        std::ifstream file(path, std::ios::binary);
+        char magic[sizeof(scalingMagic)];
+        MaintenanceTransform loaded;
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char*>(loaded.offset.data()), sizeof(loaded.offset));
+        file.read(reinterpret_cast<char*>(loaded.inverseScale.data()), sizeof(loaded.inverseScale));
+        if (!file || std::memcmp(magic, scalingMagic, sizeof(magic)) != 0) throw std::runtime_error("Not a scaling file: " + path);
+        return loaded;
+    }
+
+    static int classOf(const MaintenanceRecord& record) { return record.label != 0 ? 1 : 0; }
+
+    bool approximate() const { return retention.search == NeighborSearch::Hnsw; }
+
+    // Rebuilds the slots, class lists and feature statistics from a loaded graph, whose ids are the slots it was saved
+    // with and whose features are normalized by transform
+    void restoreFromGraph(const MaintenanceGraph& graph) {
+        std::vector<std::pair<uint32_t, MaintenanceRecord>> restored;
+        graph.forEach([&](uint32_t slot, const std::array<float, HistoryStore::dimensions>& features, int label) {
+            restored.emplace_back(slot, maintenanceRecord({features, label}, transform));
+        });
+        std::sort(restored.begin(), restored.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (size_t i = 0; i < restored.size(); ++i) {
+            if (restored[i].first != i || i >= retention.capacity) throw std::runtime_error("Index file does not match the history");
+            const MaintenanceRecord& record = restored[i].second;
+            records.push_back(record);
+            normalized.push_back(maintenanceFeatures(record, transform));
+            normalizer.add(maintenanceValues(record));
+            classPosition.push_back(static_cast<uint32_t>(classSlots[classOf(record)].size()));
+            classSlots[classOf(record)].push_back(static_cast<uint32_t>(i));
+            ++classSeen[classOf(record)];
+        }
+        seen = records.size();
+        slotChanged.assign(records.size(), 0);
+        slotRecent.assign(records.size(), 0);
+    }
+
+    size_t quota(int label) const { return label == 1 ? retention.capacity / 2 : retention.capacity - retention.capacity / 2; }
+
+    uint64_t draw(uint64_t bound) { return std::uniform_int_distribution<uint64_t>(0, bound - 1)(rng); }
+
+    void markChanged(uint32_t slot) {
+        if (slot >= slotChanged.size()) {
+            slotChanged.resize(slot + 1, 0);
+            slotRecent.resize(slot + 1, 0);
+        }
+        if (!slotRecent[slot]) {
+            slotRecent[slot] = 1;
+            recentSlots.push_back(slot);
+        }
+        if (slotChanged[slot]) return;
+        slotChanged[slot] = 1;
+        changedSlots.push_back(slot);
+    }
+
+    void occupy(uint32_t slot, const MaintenanceRecord& record) {
+        normalized[slot] = maintenanceFeatures(record, transform);
+        int label = classOf(record);
+        classPosition[slot] = static_cast<uint32_t>(classSlots[label].size());
+        classSlots[label].push_back(slot);
+        markChanged(slot);
+    }
+
+    void vacate(uint32_t slot) {
+        std::vector<uint32_t>& members = classSlots[classOf(records[slot])];
+        uint32_t moved = members.back();
+        members[classPosition[slot]] = moved;
+        classPosition[moved] = classPosition[slot];
+        members.pop_back();
+        ++evicted;
+    }
+
+    // Slot the record should replace in a full store, or none when the record is dropped
+    std::optional<uint32_t> victim(const MaintenanceRecord& record) {
+        if (retention.policy == RetentionPolicy::Reservoir) {
+            uint64_t pick = draw(seen);
+            if (pick >= records.size()) return std::nullopt;
+            return static_cast<uint32_t>(pick);
+        }
+        int label = classOf(record);
+        // Below its share the label takes room from the other one, which must then be above its own share
+        if (classSlots[label].size() < quota(label)) {
+            const std::vector<uint32_t>& other = classSlots[1 - label];
+            return other[draw(other.size())];
+        }
+        // Otherwise the label keeps a uniform sample of its own records
+        uint64_t pick = draw(classSeen[label]);
+        if (pick >= classSlots[label].size()) return std::nullopt;
+        return classSlots[label][pick];
+    }
+
+    void store(const MaintenanceRecord& record) {
+        ++seen;
+        ++classSeen[classOf(record)];
+        normalizer.add(maintenanceValues(record));
+        if (records.size() < retention.capacity) {
+            uint32_t slot = static_cast<uint32_t>(records.size());
+            records.push_back(record);
+            normalized.emplace_back();
+            classPosition.push_back(0);
+            occupy(slot, record);
+            return;
+        }
+        std::optional<uint32_t> slot = victim(record);
+        if (!slot) return;
+        vacate(*slot);
+        records[*slot] = record;
+        occupy(*slot, record);
+    }
+
+    // Brings a copy of a published base up to date with the changed slots, which are never empty
+    template<typename Base>
+    void applyChanges(Base& base) const {
+        for (uint32_t slot : changedSlots) {
+            base.remove(slot);
+            base.insert(slot, normalized[slot], records[slot].label);
+        }
+    }
+
+    // Cuts a new base holding every slot: a copy of the previous graph with the changes applied, or a fresh index or
+    // graph when the transform has just changed; a kd-tree is always rebuilt, as a balanced build is cheaper than
+    // updating a copy once 1/cutFraction of it has changed
+    void cut(const Version& previous, Version& next, bool renormalized) {
+        if (approximate() && !renormalized) {
+            auto graph = std::make_shared<MaintenanceGraph>(*previous.graph);
+            applyChanges(*graph);
+            next.graph = std::move(graph);
+        } else if (approximate()) {
+            auto graph = std::make_shared<MaintenanceGraph>(retention.hnsw);
+            graph->reserve(records.size());
+            for (size_t i = 0; i < records.size(); ++i) graph->insert(static_cast<uint32_t>(i), normalized[i], records[i].label);
+            next.graph = std::move(graph);
+        } else {
+            std::vector<int> labels(records.size());
+            for (size_t i = 0; i < records.size(); ++i) labels[i] = records[i].label;
+            auto index = std::make_shared<MaintenanceIndex>();
+            index->insertBatch(0, normalized, labels);
+            next.index = std::move(index);
+        }
+        for (uint32_t slot : changedSlots) slotChanged[slot] = 0;
+        changedSlots.clear();
+        for (uint32_t slot : recentSlots) slotRecent[slot] = 0;
+        recentSlots.clear();
+        deltas.clear();
+    }
+
+    // Freezes the recent slots into a new delta, first merging in each newest delta at most twice the size of the slots
+    // gathered so far; deltas then shrink geometrically from oldest to newest, so there are O(log N) of them and a slot
+    // is rebuilt into O(log N) deltas before the next cut
+    void freeze() {
+        std::vector<uint32_t> slots = recentSlots;
+        std::sort(slots.begin(), slots.end());
+        while (!deltas.empty() && deltas.back()->slots.size() <= 2 * slots.size()) {
+            std::vector<uint32_t> merged;
+            merged.reserve(deltas.back()->slots.size() + slots.size());
+            std::set_union(deltas.back()->slots.begin(), deltas.back()->slots.end(), slots.begin(), slots.end(),
+                           std::back_inserter(merged));
+            slots = std::move(merged);
+            deltas.pop_back();
+        }
+        std::vector<MaintenanceIndex::Point> points(slots.size());
+        std::vector<int> labels(slots.size());
+        for (size_t i = 0; i < slots.size(); ++i) {
+            points[i] = normalized[slots[i]];
+            labels[i] = records[slots[i]].label;
+        }
+        auto delta = std::make_shared<Version::Delta>();
+        delta->index.insertBatch(0, points, labels);
+        delta->slots = std::move(slots);
+        deltas.push_back(std::move(delta));
+        for (uint32_t slot : recentSlots) slotRecent[slot] = 0;
+        recentSlots.clear();
+    }
+
+    // Adopts the learned normalization once a scale has drifted past the tolerance, renormalizing every slot; the
+    // statistics settle as records accumulate, so this grows rare unless the operating range itself moves
+    bool renormalize() {
+        if (retention.scaling == FeatureScaling::Fixed) return false;
+        MaintenanceTransform learned = normalizer.transform(retention.scaling, fixedMaintenanceTransform());
+        if (!learned.scalesDiffer(transform, retention.rescaleTolerance)) return false;
+        transform = learned;
+        for (size_t i = 0; i < records.size(); ++i) normalized[i] = maintenanceFeatures(records[i], transform);
+        return true;
+    }
+
+    // Makes the writes so far visible to readers; queries already running keep the version they started with
+    void publish() {
+        std::shared_ptr<const Version> previous = published.load();
+        auto next = std::make_shared<Version>();
+        bool renormalized = renormalize();
+        bool full = recentSlots.size() > maxRecentSlots;
+        if (renormalized || (full && changedSlots.size() * cutFraction >= records.size())) {
+            cut(*previous, *next, renormalized);
+        } else {
+            if (full) freeze();
+            next->index = previous->index;
+            next->graph = previous->graph;
+            next->deltas = deltas;
+            next->changed = recentSlots;
+            std::sort(next->changed.begin(), next->changed.end());
+            next->recent.reserve(next->changed.size());
+            for (uint32_t slot : next->changed) {
+                next->recent.push(Version::narrow(normalized[slot]), records[slot].label, slot);
+            }
+        }
+        next->transform = transform;
+        next->count = records.size();
+        published.store(std::move(next));
+    }
+
+public:
+    explicit MaintenanceHistory(const HistoryRetention& retention = HistoryRetention(), unsigned int seed = 0)
+        : retention(retention), rng(seed) {
+        this->retention.capacity = std::max<size_t>(2, retention.capacity);
+        if (!retention.storeDirectory.empty()) {
+            persistent = std::make_unique<HistoryStore>(retention.storeDirectory, retention.compactThreshold);
+            return;
+        }
+        auto initial = std::make_shared<Version>();
+        if (approximate()) {
+            auto graph = std::make_shared<MaintenanceGraph>(retention.hnsw);
+            if (!retention.hnswIndexPath.empty() && std::filesystem::exists(retention.hnswIndexPath)) {
+                graph->load(retention.hnswIndexPath);
+                transform = loadTransform(scalingPath(retention.hnswIndexPath));
+                restoreFromGraph(*graph);
+            }
+            initial->graph = std::move(graph);
+        } else {
+            initial->index = std::make_shared<MaintenanceIndex>();
+        }
+        initial->transform = transform;
+        initial->count = records.size();
+        published.store(std::move(initial));
+    }
+
+    bool isPersistent() const { return persistent != nullptr; }
+    // The backing store of a persistent history, for flush() and compact(); null otherwise
+    HistoryStore* persistentStore() const { return persistent.get(); }
+
+    // The latest published state of an in-memory history, for a run of queries that must all see the same records;
+    // null for a persistent history
+    std::shared_ptr<const Version> current() const { return published.load(); }
+
+    void append(const MaintenanceRecord& record) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (persistent) {
+            ++seen;
+            persistent->append(maintenanceFeatures(record), record.label);
+            return;
+        }
+        store(record);
+        publish();
+    }
+
+    // Readers see either none or all of the batch
+    void appendAll(const std::vector<MaintenanceRecord>& batch) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (persistent) {
+            seen += batch.size();
+            std::vector<HistoryStore::StoredPoint> points(batch.size());
+            for (size_t i = 0; i < batch.size(); ++i) {
+                MaintenanceIndex::Point features = maintenanceFeatures(batch[i]);
+                for (size_t d = 0; d < HistoryStore::dimensions; ++d) points[i].features[d] = static_cast<float>(features[d]);
+                points[i].label = batch[i].label;
+            }
+            persistent->appendAll(points);
+            return;
+        }
+        for (const auto& record : batch) store(record);
+        publish();
+    }
+
+    // Up to k records closest to query in normalized feature space, closest first; returns how many were written
+    size_t nearest(const MaintenanceRecord& query, size_t k, MaintenanceIndex::Neighbor* best) const {
+        if (persistent) return persistent->nearest(maintenanceFeatures(query), k, best);
+        return published.load()->nearest(query, k, best);
+    }
+
+    // nearest() for a batch against one version: best holds k slots per query and found receives each query's count
+    void nearestBatch(std::span<const MaintenanceRecord> queries, size_t k, MaintenanceIndex::Neighbor* best, size_t* found) const {
+        if (persistent) {
+            std::vector<MaintenanceIndex::Point> points(queries.size());
+            for (size_t i = 0; i < queries.size(); ++i) points[i] = maintenanceFeatures(queries[i]);
+            persistent->nearestBatch(points.data(), points.size(), k, best, found);
+            return;
+        }
+        published.load()->nearestBatch(queries, k, best, found);
+    }
+
+    // The recall/latency dial of NeighborSearch::Hnsw (see HnswParameters::searchBreadth). Publishes a copy of the
+    // graph, so it is meant for tuning rather than for every query.
+    void setSearchBreadth(size_t breadth) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        retention.hnsw.searchBreadth = breadth;
+        if (persistent || !approximate()) return;
+        std::shared_ptr<const Version> previous = published.load();
+        auto next = std::make_shared<Version>(*previous);
+        auto graph = std::make_shared<MaintenanceGraph>(*previous->graph);
+        graph->setSearchBreadth(breadth);
+        next->graph = std::move(graph);
+        published.store(std::move(next));
+    }
+
+    // Writes the HNSW graph, and with it the records, to retention.hnswIndexPath or path, and the feature normalization
+    // to a ".scaling" file beside it
+    void saveNeighborIndex(const std::string& path = std::string()) const {
+        std::string target = path.empty() ? retention.hnswIndexPath : path;
+        if (!approximate() || persistent || target.empty()) {
+            throw std::logic_error("Only an in-memory history searched by HNSW has an index to save, and it needs a path");
+        }
+        std::lock_guard<std::mutex> lock(writeMutex);
+        std::shared_ptr<const Version> version = published.load();
+        saveTransform(version->transform, scalingPath(target));
+        if (changedSlots.empty()) {
+            version->graph->save(target);
+            return;
+        }
+        MaintenanceGraph graph = *version->graph;
+        applyChanges(graph);
+        graph.save(target);
+    }
+
+    // Runs queries against the active index and against an exact kd-tree built over a snapshot of the records.
+    // Recall counts the returned records no farther than the exact k-th nearest one.
+    NeighborRecall measureRecall(std::span<const MaintenanceRecord> queries, size_t k) const {
+        NeighborRecall result;
+        result.queries = queries.size();
+        result.k = k;
+        std::vector<MaintenanceRecord> stored;
+        MaintenanceTransform scaling = fixedMaintenanceTransform();
+        if (persistent) {
+            stored = snapshot();
+        } else {
+            std::lock_guard<std::mutex> lock(writeMutex);
+            stored = records;
+            scaling = transform;
+        }
+        MaintenanceIndex exact;
+        exact.reserve(stored.size());
+        for (size_t i = 0; i < stored.size(); ++i) exact.insert(static_cast<uint32_t>(i), maintenanceFeatures(stored[i], scaling), stored[i].label);
+        exact.rebuild();
+        if (queries.empty() || k == 0) return result;
+
+        std::vector<MaintenanceIndex::Neighbor> approximateBest(k);
+        std::vector<MaintenanceIndex::Neighbor> exactBest(k);
+        size_t expected = 0;
+        size_t recalled = 0;
+        std::chrono::duration<double, std::micro> indexTime(0);
+        std::chrono::duration<double, std::micro> exactTime(0);
+        for (const MaintenanceRecord& query : queries) {
+            auto started = std::chrono::steady_clock::now();
+            size_t approximateFound = nearest(query, k, approximateBest.data());
+            auto middle = std::chrono::steady_clock::now();
+            size_t exactFound = exact.nearest(maintenanceFeatures(query, scaling), k, exactBest.data());
+            indexTime += middle - started;
+            exactTime += std::chrono::steady_clock::now() - middle;
+            expected += exactFound;
+            if (exactFound == 0) continue;
+            // Relative slack absorbs float32 rounding of records read back from a store
+            float limit = exactBest[exactFound - 1].distance * (1.0f + 1e-5f) + 1e-12f;
+            for (size_t j = 0; j < approximateFound; ++j) {
+                if (approximateBest[j].distance <= limit) ++recalled;
+            }
+        }
+        result.recall = expected == 0 ? 1.0 : static_cast<double>(recalled) / expected;
+        result.indexMicros = indexTime.count() / queries.size();
+        result.exactMicros = exactTime.count() / queries.size();
+        return result;
+    }
+
+    size_t size() const {
+        if (persistent) return persistent->size();
+        return published.load()->size();
+    }
+
+    size_t capacity() const { return retention.capacity; }
+
+    // Records ever appended through this instance, and records evicted to make room for later ones (never, when
+    // persistent)
+    uint64_t appendedCount() const {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        return seen;
+    }
+    uint64_t evictedCount() const {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        return evicted;
+    }
+
+    // Copies the records as of the last append; a persistent history reads them back from the store, rounded to
+    // float32 precision
+    std::vector<MaintenanceRecord> snapshot() const {
+        if (persistent) {
+            std::vector<MaintenanceRecord> result;
+            for (const HistoryStore::StoredPoint& point : persistent->points()) result.push_back(maintenanceRecord(point));
+            return result;
+        }
+        std::lock_guard<std::mutex> lock(writeMutex);
+        return records;
+    }
+};
+
+#endif // MAINTENANCE_HISTORY_HPP
@@ -0,0 +1,74 @@
+#include "MappedFile.hpp"
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path) {
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                       FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        file = nullptr;
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        release();
+        throw std::runtime_error("Cannot read the size of file: " + path);
+    }
+    length = static_cast<size_t>(fileSize.QuadPart);
+    if (length == 0) return;  // Windows cannot map an empty file
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping != nullptr) bytes = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (bytes == nullptr) {
+        release();
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+}
+
+void MappedFile::release() {
+    if (bytes != nullptr) UnmapViewOfFile(bytes);
+    if (mapping != nullptr) CloseHandle(mapping);
+    if (file != nullptr) CloseHandle(file);
+    bytes = nullptr;
+    mapping = nullptr;
+    file = nullptr;
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) {
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) throw std::runtime_error("Cannot open file: " + path);
+    struct stat status;
+    if (fstat(descriptor, &status) != 0) {
+        close(descriptor);
+        throw std::runtime_error("Cannot read the size of file: " + path);
+    }
+    length = static_cast<size_t>(status.st_size);
+    if (length > 0) {
+        void* address = mmap(nullptr, length, PROT_READ, MAP_SHARED, descriptor, 0);
+        if (address != MAP_FAILED) bytes = static_cast<const unsigned char*>(address);
+    }
+    close(descriptor);  // The mapping keeps the file referenced
+    if (length > 0 && bytes == nullptr) throw std::runtime_error("Cannot map file: " + path);
+}
+
+void MappedFile::release() {
+    if (bytes != nullptr) munmap(const_cast<unsigned char*>(bytes), length);
+    bytes = nullptr;
+}
+
+#endif
+
+MappedFile::~MappedFile() { release(); }
@@ -0,0 +1,626 @@
+#ifndef MOGA_ENGINE_HPP
+#define MOGA_ENGINE_HPP
+
+#include "InitialDesign.hpp"
+#include "MogaProblem.hpp"
+#include "OptimizationSettings.hpp"
+#include "ParallelEvaluator.hpp"
+#include "ParetoArchive.hpp"
+#include "ParetoRanking.hpp"
+#include "Telemetry.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+template<MogaProblem Problem>
+class MogaEngine {
+public:
+    static constexpr std::size_t objectiveCount = Problem::objectiveCount;
+    static constexpr std::size_t continuousGenes = Problem::continuousGenes;
+    static constexpr std::size_t categoricalGenes = Problem::categoricalGenes;
+
+    using GenomeType = Genome<continuousGenes, categoricalGenes>;
+    using Objectives = std::array<double, objectiveCount>;
+    using Fronts = std::vector<std::vector<size_t>>;
+    using MessageSink = std::function<void(EngineMessage, const std::string&)>;
+
+    // Operator parameters an offspring was created with, kept so its survival can credit them
+    struct VariationParameters {
+        double alpha = 0.5;
+        double eta = 20.0;
+        double mutationRate = 0.1;
+        double categoricalRate = 0.1;
+        bool continuousMutated = false;
+        bool categoricalMutated = false;
+    };
+
+    // Per-generation adaptation state: memory means and how often each operator produced a survivor
+    struct AdaptationRecord {
+        int generation = 0;
+        double alpha = 0.0;
+        double eta = 0.0;
+        double mutationRate = 0.0;
+        double categoricalRate = 0.0;
+        size_t crossoverApplications = 0;
+        size_t crossoverSuccesses = 0;
+        size_t mutationApplications = 0;
+        size_t mutationSuccesses = 0;
+        size_t categoricalApplications = 0;
+        size_t categoricalSuccesses = 0;
+    };
+
+    struct Individual {
+        GenomeType genome;
+        Objectives objectives{};
+        int rank = 0;
+        double crowdingDistance = 0.0;
+        double preferenceDistance = 0.0; // R-NSGA-II rank-based distance to the closest reference point (lower is better)
+        int birthGeneration = 0;
+        VariationParameters variation;
+    };
+    using Population = std::vector<Individual>;
+    using GenerationObserver = std::function<void(int generation, const Population& population)>; // Generation 0 is the initial population
+
+private:
+    using Evaluator = ParallelEvaluator<Problem>;
+    using CacheKey = typename Evaluator::CacheKey;
+    using CacheKeyHash = typename Evaluator::CacheKeyHash;
+
+    std::unique_ptr<Evaluator> ownedEvaluator;
+    Evaluator* evaluator;   // ownedEvaluator, or one shared with other engines
+    ParetoArchive<Problem>* archive;
+    int archiveSource;
+    OptimizationSettings settings;
+    std::mt19937 rng;
+    std::vector<Objectives> referencePoints;
+    std::vector<GenomeType> seedGenomes;
+    MessageSink messageSink;
+    GenerationObserver generationObserver;
+    SearchControl control;
+    int completedGenerations;
+    TelemetryRecorder<objectiveCount> telemetry;
+    int acceptedRefinements;
+
+    // Success-history memory (one value per slot) and the adaptation trace
+    std::vector<VariationParameters> parameterMemory;
+    size_t nextMemorySlot;
+    std::vector<AdaptationRecord> adaptation;
+
+    void report(EngineMessage kind, const std::string& message) const;
+    void evaluate(Individual& ind, std::mt19937& generator);
+    bool evaluateBatch(std::vector<Individual>& individuals);
+    VariationParameters sampleVariation();
+    Individual crossover(const Individual& parent1, const Individual& parent2, const VariationParameters& variation);
+    void mutate(Individual& ind);
+    void updateParameterMemory(const Population& survivors, const Population& offspring, int generation);
+    void assignCrowdingDistances(Population& population, const Fronts& fronts) const;
+    void assignPreferenceDistances(Population& population, const Fronts& fronts);
+    bool isPreferred(const Individual& a, const Individual& b) const;
+    Population selectSurvivors(const Population& combined, const Fronts& fronts, size_t populationSize) const;
+
+    // Memetic local search
+    std::vector<size_t> selectMemeticCandidates(const Population& population) const;
+    Individual refineIndividual(const Individual& start, const Objectives& scale, unsigned int seed);
+
+    MogaEngine(std::unique_ptr<Evaluator> owned, Evaluator* shared, const OptimizationSettings& settings, unsigned int seed);
+
+public:
+    MogaEngine(const Problem& problem, const OptimizationSettings& settings, unsigned int seed)
+        : MogaEngine(std::make_unique<Evaluator>(problem, settings.workerThreads, settings.evaluationCacheCapacity), nullptr, settings, seed) {}
+    // Shares the evaluation backend (pool, cache, evaluation count) with other engines
+    MogaEngine(Evaluator& evaluator, const OptimizationSettings& settings, unsigned int seed)
+        : MogaEngine(nullptr, &evaluator, settings, seed) {}
+
+    MogaEngine(const MogaEngine&) = delete;
+    MogaEngine& operator=(const MogaEngine&) = delete;
+
+    void setReferencePoints(const std::vector<Objectives>& points) { referencePoints = points; }
+    void setSeedGenomes(const std::vector<GenomeType>& genomes) { seedGenomes = genomes; }
+    void setMessageSink(MessageSink sink) { messageSink = std::move(sink); }
+    void setGenerationObserver(GenerationObserver observer) { generationObserver = std::move(observer); }
+    void setControl(const SearchControl& stopControl) { control = stopControl; }
+    void setTelemetrySink(TelemetrySink<objectiveCount> sink) { telemetry.setSink(std::move(sink)); }
+    // Every evaluated individual is offered to the archive, tagged with source
+    void setArchive(ParetoArchive<Problem>* target, int source) {
+        archive = target;
+        archiveSource = source;
+    }
+
+    Population run(int populationSize, int generations);
+
+    size_t evaluationCount() const { return evaluator->evaluationCount(); }
+    int generationsCompleted() const { return completedGenerations; } // Below the requested count when stopped early
+    int refinementsAccepted() const { return acceptedRefinements; }
+    const std::vector<AdaptationRecord>& adaptationHistory() const { return adaptation; }
+
+    static CacheKey makeCacheKey(const GenomeType& genome) { return Evaluator::makeCacheKey(genome); }
+    static bool dominates(const Objectives& a, const Objectives& b) { return dominatesObjectives(a, b); }
+    static bool dominates(const Individual& a, const Individual& b) { return dominates(a.objectives, b.objectives); }
+    static double achievementScalarizing(const Objectives& objectives, const Objectives& reference, const Objectives& scale);
+    Fronts nonDominatedSorting(Population& population) const;
+};
+
+template<MogaProblem Problem>
+MogaEngine<Problem>::MogaEngine(std::unique_ptr<Evaluator> owned, Evaluator* shared, const OptimizationSettings& settings,
+                                unsigned int seed)
+    : ownedEvaluator(std::move(owned)), evaluator(ownedEvaluator ? ownedEvaluator.get() : shared), archive(nullptr),
+      archiveSource(0), settings(settings), rng(seed), completedGenerations(0), acceptedRefinements(0), nextMemorySlot(1) {
+    VariationParameters initial;
+    initial.alpha = settings.crossoverAlpha;
+    initial.eta = settings.mutationEta;
+    initial.mutationRate = settings.mutationRate;
+    initial.categoricalRate = settings.mutationRate;
+    parameterMemory.assign(static_cast<size_t>(std::max(1, settings.adaptationMemory)) + 1, initial); // Slot 0 is never overwritten
+}
+
+template<MogaProblem Problem>
+void MogaEngine<Problem>::report(EngineMessage kind, const std::string& message) const {
+    if (messageSink) messageSink(kind, message);
+}
+
+template<MogaProblem Problem>
+double MogaEngine<Problem>::achievementScalarizing(const Objectives& objectives, const Objectives& reference, const Objectives& scale) {
+    const double rho = 1e-4; // Augmentation term keeps the ASF from accepting weakly dominated moves
+    double worst = -std::numeric_limits<double>::infinity();
+    double sum = 0.0;
+    for (size_t i = 0; i < objectiveCount; ++i) {
+        double term = (objectives[i] - reference[i]) / scale[i];
+        worst = std::max(worst, term);
+        sum += term;
+    }
+    return worst + rho * sum;
+}
+
+template<MogaProblem Problem>
+void MogaEngine<Problem>::evaluate(Individual& ind, std::mt19937& generator) {
+    evaluator->evaluate(ind.genome, ind.objectives, generator);
+    if (archive) archive->insert(ind.genome, ind.objectives, archiveSource);
+}
+
+template<MogaProblem Problem>
+bool MogaEngine<Problem>::evaluateBatch(std::vector<Individual>& individuals) {
+    bool complete = evaluator->evaluateBatch(individuals, rng, control);
+    if (archive) archive->insertAll(individuals, archiveSource);
+    return complete;
+}
+
+template<MogaProblem Problem>
+typename MogaEngine<Problem>::VariationParameters MogaEngine<Problem>::sampleVariation() {
+    VariationParameters variation;
+    variation.alpha = settings.crossoverAlpha;
+    variation.eta = settings.mutationEta;
+    variation.mutationRate = settings.mutationRate;
+    variation.categoricalRate = settings.mutationRate;
+    if (settings.parameterControl == ParameterControl::Fixed) return variation;
+
+    // Draw around a random memory slot, clipped to ranges where each operator stays meaningful
+    std::uniform_int_distribution<size_t> slotDist(0, parameterMemory.size() - 1);
+    const VariationParameters& slot = parameterMemory[slotDist(rng)];
+    auto sample = [&](double mean, double spread, double lowest, double highest) {
+        std::normal_distribution<double> dist(mean, spread);
+        return std::max(lowest, std::min(highest, dist(rng)));
+    };
+    variation.alpha = sample(slot.alpha, 0.1, 0.0, 1.0);
+    variation.eta = sample(slot.eta, 5.0, 2.0, 100.0);
+    variation.mutationRate = sample(slot.mutationRate, 0.05, 0.01, 0.5);
+    variation.categoricalRate = sample(slot.categoricalRate, 0.05, 0.01, 0.5);
+    return variation;
+}
+
+template<MogaProblem Problem>
+typename MogaEngine<Problem>::Individual MogaEngine<Problem>::crossover(const Individual& parent1, const Individual& parent2,
+                                                                        const VariationParameters& variation) {
+    Individual offspring;
+    offspring.variation = variation;
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    double alpha = variation.alpha; // BLX-α parameter
+
+    // Continuous genes (BLX-α on the normalized range)
+    for (size_t i = 0; i < continuousGenes; ++i) {
+        double p1 = parent1.genome.continuous[i];
+        double p2 = parent2.genome.continuous[i];
+        double d = std::abs(p1 - p2);
+        double lower = std::min(p1, p2) - alpha * d;
+        double upper = std::max(p1, p2) + alpha * d;
+        offspring.genome.continuous[i] = std::max(0.0, std::min(1.0, lower + dist(rng) * (upper - lower)));
+    }
+
+    // Categorical genes (uniform crossover)
+    for (size_t i = 0; i < categoricalGenes; ++i) {
+        offspring.genome.categorical[i] = dist(rng) < 0.5 ? parent1.genome.categorical[i] : parent2.genome.categorical[i];
+    }
+    return offspring;
+}
+
+template<MogaProblem Problem>
+void MogaEngine<Problem>::mutate(Individual& ind) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    double mutationProb = ind.variation.mutationRate;
+    double eta = ind.variation.eta;
+
+    // Continuous genes (polynomial mutation)
+    for (auto& value : ind.genome.continuous) {
+        if (dist(rng) >= mutationProb) continue;
+        ind.variation.continuousMutated = true;
+        double rand = dist(rng);
+        double deltaq = (rand <= 0.5) ?
+            std::pow(2.0 * rand, 1.0 / (eta + 1.0)) - 1.0 :
+            1.0 - std::pow(2.0 * (1.0 - rand), 1.0 / (eta + 1.0));
+        double delta = (deltaq < 0 ? value : 1.0 - value) * deltaq;
+        value = std::max(0.0, std::min(1.0, value + delta));
+    }
+
+    // Categorical genes
+    for (size_t i = 0; i < categoricalGenes; ++i) {
+        if (dist(rng) < ind.variation.categoricalRate) {
+            ind.variation.categoricalMutated = true;
+            ind.genome.categorical[i] = std::min(Problem::categoryCounts[i] - 1, static_cast<int>(dist(rng) * Problem::categoryCounts[i]));
+        }
+    }
+}
+
+template<MogaProblem Problem>
+void MogaEngine<Problem>::updateParameterMemory(const Population& survivors, const Population& offspring, int generation) {
+    AdaptationRecord record;
+    record.generation = generation;
+    for (const auto& child : offspring) {
+        record.crossoverApplications++;
+        if (child.variation.continuousMutated) record.mutationApplications++;
+        if (child.variation.categoricalMutated) record.categoricalApplications++;
+    }
+
+    // An offspring succeeds when it reaches the first front of the next population. Slot 0 keeps the configured values
+    // so the search never loses the baseline operators; eta is averaged harmonically like a step size
+    double alphaSum = 0.0, inverseEtaSum = 0.0, rateSum = 0.0, categoricalSum = 0.0;
+    for (const auto& ind : survivors) {
+        if (ind.birthGeneration != generation || ind.rank != 1) continue;
+        record.crossoverSuccesses++;
+        alphaSum += ind.variation.alpha;
+        if (ind.variation.continuousMutated) {
+            record.mutationSuccesses++;
+            inverseEtaSum += 1.0 / ind.variation.eta;
+            rateSum += ind.variation.mutationRate;
+        }
+        if (ind.variation.categoricalMutated) {
+            record.categoricalSuccesses++;
+            categoricalSum += ind.variation.categoricalRate;
+        }
+    }
+    if (settings.parameterControl == ParameterControl::SuccessHistory && record.crossoverSuccesses > 0 && parameterMemory.size() > 1) {
+        VariationParameters& slot = parameterMemory[nextMemorySlot];
+        slot.alpha = alphaSum / record.crossoverSuccesses;
+        if (record.mutationSuccesses > 0) {
+            slot.eta = record.mutationSuccesses / inverseEtaSum;
+            slot.mutationRate = rateSum / record.mutationSuccesses;
+        }
+        if (record.categoricalSuccesses > 0) slot.categoricalRate = categoricalSum / record.categoricalSuccesses;
+        nextMemorySlot = nextMemorySlot + 1 < parameterMemory.size() ? nextMemorySlot + 1 : 1;
+    }
+
+    for (const auto& slot : parameterMemory) {
+        record.alpha += slot.alpha / parameterMemory.size();
+        record.eta += slot.eta / parameterMemory.size();
+        record.mutationRate += slot.mutationRate / parameterMemory.size();
+        record.categoricalRate += slot.categoricalRate / parameterMemory.size();
+    }
+    adaptation.push_back(record);
+}
+
+template<MogaProblem Problem>
+typename MogaEngine<Problem>::Fronts MogaEngine<Problem>::nonDominatedSorting(Population& population) const {
+    std::vector<Objectives> objectives;
+    objectives.reserve(population.size());
+    for (const auto& ind : population) objectives.push_back(ind.objectives);
+    Fronts fronts = sortNonDominated(objectives);
+    for (size_t f = 0; f < fronts.size(); ++f) {
+        for (size_t i : fronts[f]) population[i].rank = static_cast<int>(f) + 1;
+    }
+
+    assignCrowdingDistances(population, fronts);
+    return fronts;
+}
+
+template<MogaProblem Problem>
+void MogaEngine<Problem>::assignCrowdingDistances(Population& population, const Fronts& fronts) const {
+    std::vector<Objectives> objectives;
+    objectives.reserve(population.size());
+    for (const auto& ind : population) objectives.push_back(ind.objectives);
+    for (size_t f = 0; f < fronts.size(); ++f) {
+        const auto& front = fronts[f];
+        std::vector<double> distances = crowdingDistances(objectives, front);
+        for (size_t k = 0; k < front.size(); ++k) population[front[k]].crowdingDistance = distances[k];
+    }
+}
+
+template<MogaProblem Problem>
+void MogaEngine<Problem>::assignPreferenceDistances(Population& population, const Fronts& fronts) {
+    if (population.empty() || referencePoints.empty()) return;
+
+    // Normalize by the objective ranges of the whole population
+    Objectives lowest;
+    Objectives range;
+    lowest.fill(std::numeric_limits<double>::infinity());
+    range.fill(-std::numeric_limits<double>::infinity());
+    for (const auto& ind : population) {
+        for (size_t objIdx = 0; objIdx < objectiveCount; ++objIdx) {
+            lowest[objIdx] = std::min(lowest[objIdx], ind.objectives[objIdx]);
+            range[objIdx] = std::max(range[objIdx], ind.objectives[objIdx]);
+        }
+    }
+    for (size_t objIdx = 0; objIdx < objectiveCount; ++objIdx) {
+        range[objIdx] = std::max(range[objIdx] - lowest[objIdx], 1e-10);
+    }
+
+    for (const auto& front : fronts) {
+        for (size_t i : front) population[i].preferenceDistance = std::numeric_limits<double>::infinity();
+
+        // Each member takes its best rank by distance to any reference point
+        std::vector<std::pair<double, size_t>> distances(front.size());
+        for (const auto& reference : referencePoints) {
+            for (size_t k = 0; k < front.size(); ++k) {
+                double sum = 0.0;
+                for (size_t objIdx = 0; objIdx < objectiveCount; ++objIdx) {
+                    double diff = (population[front[k]].objectives[objIdx] - reference[objIdx]) / range[objIdx];
+                    sum += diff * diff / objectiveCount;
+                }
+                distances[k] = {std::sqrt(sum), front[k]};
+            }
+            std::sort(distances.begin(), distances.end());
+            for (size_t k = 0; k < distances.size(); ++k) {
+                double& preference = population[distances[k].second].preferenceDistance;
+                preference = std::min(preference, static_cast<double>(k + 1));
+            }
+        }
+
+        // Epsilon clearing: keep one representative per epsilon-neighbourhood, push the rest back
+        std::vector<size_t> order = front;
+        std::shuffle(order.begin(), order.end(), rng);
+        std::vector<bool> cleared(order.size(), false);
+        for (size_t a = 0; a < order.size(); ++a) {
+            if (cleared[a]) continue;
+            for (size_t b = a + 1; b < order.size(); ++b) {
+                if (cleared[b]) continue;
+                double spread = 0.0;
+                for (size_t objIdx = 0; objIdx < objectiveCount; ++objIdx) {
+                    spread += std::abs(population[order[a]].objectives[objIdx] - population[order[b]].objectives[objIdx]) / range[objIdx];
+                }
+                if (spread <= settings.referenceEpsilon) {
+                    population[order[b]].preferenceDistance += static_cast<double>(population.size());
+                    cleared[b] = true;
+                }
+            }
+        }
+    }
+}
+
+template<MogaProblem Problem>
+bool MogaEngine<Problem>::isPreferred(const Individual& a, const Individual& b) const {
+    if (a.rank != b.rank) return a.rank < b.rank;
+    if (!referencePoints.empty()) return a.preferenceDistance < b.preferenceDistance;
+    return a.crowdingDistance > b.crowdingDistance;
+}
+
+template<MogaProblem Problem>
+typename MogaEngine<Problem>::Population MogaEngine<Problem>::selectSurvivors(const Population& combined, const Fronts& fronts,
+                                                                              size_t populationSize) const {
+    Population survivors;
+    size_t frontIdx = 0;
+    while (frontIdx < fronts.size() && survivors.size() + fronts[frontIdx].size() <= populationSize) {
+        for (size_t i : fronts[frontIdx]) survivors.push_back(combined[i]);
+        frontIdx++;
+    }
+    if (survivors.size() < populationSize && frontIdx < fronts.size()) {
+        std::vector<size_t> sortedFront = fronts[frontIdx];
+        std::sort(sortedFront.begin(), sortedFront.end(), [&](size_t a, size_t b) {
+            return isPreferred(combined[a], combined[b]);
+        });
+        size_t remaining = populationSize - survivors.size();
+        for (size_t i = 0; i < remaining && i < sortedFront.size(); ++i) survivors.push_back(combined[sortedFront[i]]);
+    }
+    return survivors;
+}
+
+template<MogaProblem Problem>
+std::vector<size_t> MogaEngine<Problem>::selectMemeticCandidates(const Population& population) const {
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < population.size(); ++i) {
+        if (population[i].rank == 1) candidates.push_back(i);
+    }
+    // Prefer the least crowded members so refinements spread along the front, or those closest to the reference points
+    std::sort(candidates.begin(), candidates.end(), [&](size_t a, size_t b) {
+        return isPreferred(population[a], population[b]);
+    });
+    size_t count = static_cast<size_t>(std::max(0, settings.memeticCandidates));
+    if (candidates.size() > count) candidates.resize(count);
+    return candidates;
+}
+
+template<MogaProblem Problem>
+typename MogaEngine<Problem>::Individual MogaEngine<Problem>::refineIndividual(const Individual& start, const Objectives& scale,
+                                                                               unsigned int seed) {
+    std::mt19937 generator(seed);
+    Individual best = start;
+    double bestScore = 0.0; // The start point scores zero against itself as the aspiration level
+    int evaluationsLeft = settings.memeticEvaluationBudget;
+    double step = settings.memeticInitialStep;
+    evaluator->store(start.genome, start.objectives);
+
+    auto evaluateCandidate = [&](Individual& candidate) {
+        if (evaluator->lookup(candidate.genome, candidate.objectives)) return true;
+        if (evaluationsLeft <= 0) return false;
+        evaluate(candidate, generator);
+        --evaluationsLeft;
+        return true;
+    };
+
+    // Bounded compass search: accept the first improving move, halve the step when none improves. A stop ends the
+    // search at the next step with the best point found so far.
+    while (step >= settings.memeticMinimumStep && evaluationsLeft > 0 && !control.stopRequested()) {
+        bool improved = false;
+        for (size_t g = 0; g < continuousGenes && !improved; ++g) {
+            for (double direction : {1.0, -1.0}) {
+                Individual candidate = best;
+                double& gene = candidate.genome.continuous[g];
+                gene = std::max(0.0, std::min(1.0, gene + direction * step));
+                if (gene == best.genome.continuous[g]) continue;
+                if (!evaluateCandidate(candidate)) break;
+                double score = achievementScalarizing(candidate.objectives, start.objectives, scale);
+                if (score < bestScore) {
+                    best = candidate;
+                    bestScore = score;
+                    improved = true;
+                    break;
+                }
+            }
+        }
+        if (!improved) step *= 0.5;
+    }
+
+    best.rank = 0;
+    best.crowdingDistance = 0.0;
+    return best;
+}
+
+template<MogaProblem Problem>
+typename MogaEngine<Problem>::Population MogaEngine<Problem>::run(int populationSize, int generations) {
+    if (populationSize < 2 || generations < 0) {
+        throw std::invalid_argument("Population size must be at least 2 and generations non-negative");
+    }
+
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::uniform_int_distribution<unsigned int> seedDist;
+    bool referenceGuided = !referencePoints.empty();
+    auto reportStop = [&](int completed) {
+        report(EngineMessage::Progress, "Stopping early after " + std::to_string(completed) + "/" + std::to_string(generations) + " generations");
+    };
+
+    // Initialize population
+    report(EngineMessage::Progress, "Initializing population...");
+    telemetry.begin();
+    Population population(populationSize);
+    std::vector<GenomeType> initialGenomes = generateInitialGenomes<Problem>(population.size(), seedGenomes, settings, rng);
+    for (size_t i = 0; i < population.size(); ++i) population[i].genome = initialGenomes[i];
+    telemetry.lap(&GenerationTelemetry<objectiveCount>::variationSeconds);
+    bool initialComplete = evaluateBatch(population);
+    telemetry.lap(&GenerationTelemetry<objectiveCount>::evaluationSeconds);
+    if (!initialComplete) {
+        nonDominatedSorting(population);
+        reportStop(0);
+        return population;
+    }
+    Fronts initialFronts = nonDominatedSorting(population);
+    if (referenceGuided) assignPreferenceDistances(population, initialFronts);
+    telemetry.lap(&GenerationTelemetry<objectiveCount>::rankingSeconds);
+    telemetry.publish(0, population, evaluationCount());
+    if (generationObserver) generationObserver(0, population);
+
+    // Main loop
+    for (int gen = 0; gen < generations; ++gen) {
+        if (control.stopRequested()) {
+            reportStop(gen);
+            break;
+        }
+        telemetry.begin();
+        Population offspring;
+        offspring.reserve(populationSize);
+
+        // Memetic stage: refine selected rank-1 individuals while the offspring are evaluated
+        std::vector<std::future<Individual>> refinements;
+        std::vector<CacheKey> refinementStarts;
+        if (settings.memeticInterval > 0 && continuousGenes > 0 && (gen + 1) % settings.memeticInterval == 0) {
+            std::vector<size_t> candidates = selectMemeticCandidates(population);
+            Objectives scale;
+            for (size_t objIdx = 0; objIdx < objectiveCount; ++objIdx) {
+                double lowest = std::numeric_limits<double>::infinity();
+                double highest = -std::numeric_limits<double>::infinity();
+                for (const auto& ind : population) {
+                    if (ind.rank != 1) continue;
+                    lowest = std::min(lowest, ind.objectives[objIdx]);
+                    highest = std::max(highest, ind.objectives[objIdx]);
+                }
+                scale[objIdx] = std::max(1e-10, highest - lowest);
+            }
+            for (size_t idx : candidates) {
+                unsigned int seed = seedDist(rng);
+                refinementStarts.push_back(makeCacheKey(population[idx].genome));
+                refinements.push_back(evaluator->pool().submit([this, start = population[idx], scale, seed]() {
+                    return refineIndividual(start, scale, seed);
+                }));
+            }
+        }
+
+        // Tournament selection and offspring creation
+        while (offspring.size() < static_cast<size_t>(populationSize)) {
+            size_t idx1 = std::min(population.size() - 1, static_cast<size_t>(dist(rng) * population.size()));
+            size_t idx2 = std::min(population.size() - 1, static_cast<size_t>(dist(rng) * population.size()));
+            const Individual& parent1 = population[idx1];
+            const Individual& parent2 = population[idx2];
+            VariationParameters variation = sampleVariation();
+            Individual child = isPreferred(parent1, parent2) ? crossover(parent1, parent2, variation) : crossover(parent2, parent1, variation);
+            child.birthGeneration = gen + 1;
+            mutate(child);
+            offspring.push_back(child);
+        }
+        telemetry.lap(&GenerationTelemetry<objectiveCount>::variationSeconds);
+        bool offspringComplete = evaluateBatch(offspring);
+        telemetry.lap(&GenerationTelemetry<objectiveCount>::evaluationSeconds);
+        Population refined;
+        for (auto& refinement : refinements) refined.push_back(evaluator->pool().wait(refinement));
+
+        // A stop abandons the generation; everything evaluated so far has already reached the archive
+        if (!offspringComplete || control.stopRequested()) {
+            reportStop(gen);
+            return population;
+        }
+
+        // Combine parent, offspring and refined populations
+        Population combined = population;
+        combined.insert(combined.end(), offspring.begin(), offspring.end());
+        std::unordered_set<CacheKey, CacheKeyHash> refinedKeys;
+        for (size_t r = 0; r < refined.size(); ++r) {
+            CacheKey key = makeCacheKey(refined[r].genome);
+            if (key == refinementStarts[r] || !refinedKeys.insert(key).second) continue;
+            combined.push_back(refined[r]);
+            acceptedRefinements++;
+        }
+        telemetry.lap(&GenerationTelemetry<objectiveCount>::localSearchSeconds);
+
+        // Recompute fronts for combined population
+        Fronts fronts = nonDominatedSorting(combined);
+        if (referenceGuided) assignPreferenceDistances(combined, fronts);
+        telemetry.lap(&GenerationTelemetry<objectiveCount>::rankingSeconds);
+
+        // Populate next generation
+        population = selectSurvivors(combined, fronts, static_cast<size_t>(populationSize));
+        if (population.empty()) {
+            throw std::runtime_error("Population is empty after selection");
+        }
+        updateParameterMemory(population, offspring, gen + 1);
+        telemetry.lap(&GenerationTelemetry<objectiveCount>::selectionSeconds);
+        if (telemetry.enabled()) {
+            const AdaptationRecord& adapted = adaptation.back();
+            telemetry.current().crossoverAlpha = adapted.alpha;
+            telemetry.current().mutationEta = adapted.eta;
+            telemetry.current().mutationRate = adapted.mutationRate;
+            telemetry.current().offspringSurvivors = adapted.crossoverSuccesses;
+            telemetry.publish(gen + 1, population, evaluationCount());
+        }
+        if (generationObserver) generationObserver(gen + 1, population);
+        completedGenerations = gen + 1;
+    }
+
+    return population;
+}
+
+#endif // MOGA_ENGINE_HPP
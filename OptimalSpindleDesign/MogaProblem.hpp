@@ -0,0 +1,44 @@
+#ifndef MOGA_PROBLEM_HPP
+#define MOGA_PROBLEM_HPP
+
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <random>
+#include <stop_token>
+
+// Decision vector shared by every problem: continuous genes normalized to [0, 1] plus categorical option indices
+template<std::size_t ContinuousGenes, std::size_t CategoricalGenes>
+struct Genome {
+    std::array<double, ContinuousGenes> continuous{};
+    std::array<int, CategoricalGenes> categorical{};
+};
+
+// A problem fixes its objective count and gene layout at compile time and evaluates a genome into
+// minimized objectives using the generator it is handed (never shared state)
+template<typename P>
+concept MogaProblem = requires(const P& problem, const Genome<P::continuousGenes, P::categoricalGenes>& genome,
+                               std::array<double, P::objectiveCount>& objectives, std::mt19937& generator) {
+    requires P::objectiveCount > 0;
+    { P::categoryCounts } -> std::convertible_to<std::array<int, P::categoricalGenes>>;
+    problem.evaluate(genome, objectives, generator);
+};
+
+enum class EngineMessage {
+    Progress,  // Phase-level messages
+    Detail     // Per-individual messages
+};
+
+// Checked by the engines before each generation and by every evaluation and local-search step: a run stops early,
+// without finishing its current generation, on a stop request or once the deadline passes
+struct SearchControl {
+    std::stop_token stopToken;
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+
+    bool stopRequested() const {
+        return stopToken.stop_requested() || std::chrono::steady_clock::now() >= deadline;
+    }
+};
+
+#endif // MOGA_PROBLEM_HPP
@@ -0,0 +1,260 @@
+#ifndef MOPSO_ENGINE_HPP
+#define MOPSO_ENGINE_HPP
+
+#include "InitialDesign.hpp"
+#include "MogaProblem.hpp"
+#include "OptimizationSettings.hpp"
+#include "ParallelEvaluator.hpp"
+#include "ParetoArchive.hpp"
+#include "ParetoRanking.hpp"
+#include "Telemetry.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Multi-objective particle swarm in the style of SMPSO (Nebro et al.): constricted velocities, leaders drawn from
+// the Pareto archive by crowding tournament and polynomial turbulence on a sixth of the swarm
+template<MogaProblem Problem>
+class MopsoEngine {
+public:
+    static constexpr std::size_t objectiveCount = Problem::objectiveCount;
+    static constexpr std::size_t continuousGenes = Problem::continuousGenes;
+    static constexpr std::size_t categoricalGenes = Problem::categoricalGenes;
+
+    using GenomeType = Genome<continuousGenes, categoricalGenes>;
+    using Objectives = std::array<double, objectiveCount>;
+    using MessageSink = std::function<void(EngineMessage, const std::string&)>;
+    using Archive = ParetoArchive<Problem>;
+    using Leaders = std::vector<typename Archive::Entry>;
+    using GenerationObserver = std::function<void(int generation, const Leaders& leaders)>; // Generation 0 follows the initial swarm
+
+    struct Particle {
+        GenomeType genome;
+        Objectives objectives{};
+        std::array<double, continuousGenes> velocity{};
+        GenomeType bestGenome;
+        Objectives bestObjectives{};
+    };
+
+private:
+    using Evaluator = ParallelEvaluator<Problem>;
+
+    std::unique_ptr<Evaluator> ownedEvaluator;
+    Evaluator* evaluator;   // ownedEvaluator, or one shared with other engines
+    std::unique_ptr<Archive> ownedArchive;
+    Archive* archive;       // Leader source; ownedArchive unless one is shared
+    int archiveSource;
+    OptimizationSettings settings;
+    std::mt19937 rng;
+    std::vector<GenomeType> seedGenomes;
+    MessageSink messageSink;
+    GenerationObserver generationObserver;
+    SearchControl control;
+    int completedGenerations;
+    TelemetryRecorder<objectiveCount> telemetry;
+
+    void report(EngineMessage kind, const std::string& message) const;
+    bool evaluateBatch(std::vector<Particle>& swarm);
+    size_t selectLeader(const Leaders& leaders, const std::vector<double>& crowding);
+    void move(Particle& particle, const GenomeType& leader);
+    void turbulence(Particle& particle);
+
+    MopsoEngine(std::unique_ptr<Evaluator> owned, Evaluator* shared, const OptimizationSettings& settings, unsigned int seed)
+        : ownedEvaluator(std::move(owned)), evaluator(ownedEvaluator ? ownedEvaluator.get() : shared),
+          ownedArchive(std::make_unique<Archive>(settings.archiveCapacity)), archive(ownedArchive.get()), archiveSource(0),
+          settings(settings), rng(seed), completedGenerations(0) {}
+
+public:
+    MopsoEngine(const Problem& problem, const OptimizationSettings& settings, unsigned int seed)
+        : MopsoEngine(std::make_unique<Evaluator>(problem, settings.workerThreads, settings.evaluationCacheCapacity), nullptr, settings, seed) {}
+    // Shares the evaluation backend (pool, cache, evaluation count) with other engines
+    MopsoEngine(Evaluator& evaluator, const OptimizationSettings& settings, unsigned int seed)
+        : MopsoEngine(nullptr, &evaluator, settings, seed) {}
+
+    MopsoEngine(const MopsoEngine&) = delete;
+    MopsoEngine& operator=(const MopsoEngine&) = delete;
+
+    void setSeedGenomes(const std::vector<GenomeType>& genomes) { seedGenomes = genomes; }
+    void setMessageSink(MessageSink sink) { messageSink = std::move(sink); }
+    void setGenerationObserver(GenerationObserver observer) { generationObserver = std::move(observer); }
+    void setControl(const SearchControl& stopControl) { control = stopControl; }
+    void setTelemetrySink(TelemetrySink<objectiveCount> sink) { telemetry.setSink(std::move(sink)); }
+    // Leaders come from (and every evaluation goes to) a shared archive, tagged with source
+    void setArchive(Archive* target, int source) {
+        ownedArchive.reset();
+        archive = target;
+        archiveSource = source;
+    }
+
+    // Returns the archive contents, the swarm's approximation of the Pareto front
+    Leaders run(int swarmSize, int generations);
+
+    size_t evaluationCount() const { return evaluator->evaluationCount(); }
+    int generationsCompleted() const { return completedGenerations; } // Below the requested count when stopped early
+};
+
+template<MogaProblem Problem>
+void MopsoEngine<Problem>::report(EngineMessage kind, const std::string& message) const {
+    if (messageSink) messageSink(kind, message);
+}
+
+template<MogaProblem Problem>
+bool MopsoEngine<Problem>::evaluateBatch(std::vector<Particle>& swarm) {
+    bool complete = evaluator->evaluateBatch(swarm, rng, control);
+    archive->insertAll(swarm, archiveSource);
+    return complete;
+}
+
+template<MogaProblem Problem>
+size_t MopsoEngine<Problem>::selectLeader(const Leaders& leaders, const std::vector<double>& crowding) {
+    // Binary tournament favoring the less crowded leader spreads the swarm along the front
+    std::uniform_int_distribution<size_t> pick(0, leaders.size() - 1);
+    size_t first = pick(rng);
+    size_t second = pick(rng);
+    return crowding[first] >= crowding[second] ? first : second;
+}
+
+template<MogaProblem Problem>
+void MopsoEngine<Problem>::move(Particle& particle, const GenomeType& leader) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::uniform_real_distribution<double> acceleration(1.5, 2.5);
+    const double inertia = 0.1;
+    const double maxVelocity = 0.5; // Half of the normalized gene range
+
+    double c1 = acceleration(rng);
+    double c2 = acceleration(rng);
+    double phi = c1 + c2;
+    double constriction = phi > 4.0 ? 2.0 / (2.0 - phi - std::sqrt(phi * phi - 4.0 * phi)) : 1.0;
+    for (size_t i = 0; i < continuousGenes; ++i) {
+        double r1 = dist(rng);
+        double r2 = dist(rng);
+        double& value = particle.genome.continuous[i];
+        double& velocity = particle.velocity[i];
+        velocity = constriction * (inertia * velocity + c1 * r1 * (particle.bestGenome.continuous[i] - value) +
+                                   c2 * r2 * (leader.continuous[i] - value));
+        velocity = std::max(-maxVelocity, std::min(maxVelocity, velocity));
+        value += velocity;
+        if (value < 0.0 || value > 1.0) {
+            value = std::max(0.0, std::min(1.0, value));
+            velocity = -velocity; // Bounce back into the box
+        }
+    }
+
+    // Options have no velocity: keep, follow the personal best or follow the leader in proportion to the same weights
+    std::uniform_real_distribution<double> share(0.0, inertia + c1 + c2);
+    for (size_t i = 0; i < categoricalGenes; ++i) {
+        double draw = share(rng);
+        if (draw < inertia) continue;
+        particle.genome.categorical[i] = draw < inertia + c1 ? particle.bestGenome.categorical[i] : leader.categorical[i];
+    }
+}
+
+template<MogaProblem Problem>
+void MopsoEngine<Problem>::turbulence(Particle& particle) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    double eta = settings.mutationEta;
+    double rate = continuousGenes > 0 ? 1.0 / continuousGenes : 0.0;
+    for (auto& value : particle.genome.continuous) {
+        if (dist(rng) >= rate) continue;
+        double rand = dist(rng);
+        double deltaq = (rand <= 0.5) ?
+            std::pow(2.0 * rand, 1.0 / (eta + 1.0)) - 1.0 :
+            1.0 - std::pow(2.0 * (1.0 - rand), 1.0 / (eta + 1.0));
+        double delta = (deltaq < 0 ? value : 1.0 - value) * deltaq;
+        value = std::max(0.0, std::min(1.0, value + delta));
+    }
+    for (size_t i = 0; i < categoricalGenes; ++i) {
+        if (dist(rng) < settings.mutationRate) {
+            particle.genome.categorical[i] = std::min(Problem::categoryCounts[i] - 1, static_cast<int>(dist(rng) * Problem::categoryCounts[i]));
+        }
+    }
+}
+
+template<MogaProblem Problem>
+typename MopsoEngine<Problem>::Leaders MopsoEngine<Problem>::run(int swarmSize, int generations) {
+    if (swarmSize < 2 || generations < 0) {
+        throw std::invalid_argument("Swarm size must be at least 2 and generations non-negative");
+    }
+
+    auto reportStop = [&](int completed) {
+        report(EngineMessage::Progress, "Stopping early after " + std::to_string(completed) + "/" + std::to_string(generations) + " generations");
+    };
+
+    report(EngineMessage::Progress, "Initializing MOPSO swarm...");
+    telemetry.begin();
+    std::vector<Particle> swarm(swarmSize);
+    std::vector<GenomeType> initialGenomes = generateInitialGenomes<Problem>(swarm.size(), seedGenomes, settings, rng);
+    for (size_t i = 0; i < swarm.size(); ++i) swarm[i].genome = initialGenomes[i];
+    telemetry.lap(&GenerationTelemetry<objectiveCount>::variationSeconds);
+    bool initialComplete = evaluateBatch(swarm);
+    telemetry.lap(&GenerationTelemetry<objectiveCount>::evaluationSeconds);
+    if (!initialComplete) {
+        reportStop(0);
+        return archive->snapshot();
+    }
+    for (auto& particle : swarm) {
+        particle.bestGenome = particle.genome;
+        particle.bestObjectives = particle.objectives;
+    }
+    if (telemetry.enabled() || generationObserver) {
+        Leaders leaders = archive->snapshot();
+        telemetry.publish(0, leaders, evaluationCount());
+        if (generationObserver) generationObserver(0, leaders);
+    }
+
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    for (int gen = 0; gen < generations; ++gen) {
+        if (control.stopRequested()) {
+            reportStop(gen);
+            break;
+        }
+        telemetry.begin();
+        Leaders leaders = archive->snapshot();
+        std::vector<Objectives> leaderObjectives;
+        std::vector<size_t> leaderIndices(leaders.size());
+        for (size_t i = 0; i < leaders.size(); ++i) {
+            leaderObjectives.push_back(leaders[i].objectives);
+            leaderIndices[i] = i;
+        }
+        std::vector<double> crowding = crowdingDistances(leaderObjectives, leaderIndices);
+        telemetry.lap(&GenerationTelemetry<objectiveCount>::rankingSeconds);
+
+        for (size_t i = 0; i < swarm.size(); ++i) {
+            move(swarm[i], leaders[selectLeader(leaders, crowding)].genome);
+            if (i % 6 == 0) turbulence(swarm[i]);
+        }
+        telemetry.lap(&GenerationTelemetry<objectiveCount>::variationSeconds);
+        bool swarmComplete = evaluateBatch(swarm);
+        telemetry.lap(&GenerationTelemetry<objectiveCount>::evaluationSeconds);
+        if (!swarmComplete) {
+            // The evaluated positions have already reached the archive, which is the result
+            reportStop(gen);
+            return archive->snapshot();
+        }
+
+        // A new position replaces the personal best unless dominated by it; mutually non-dominated positions win half the time
+        for (auto& particle : swarm) {
+            bool replace = dominatesObjectives(particle.objectives, particle.bestObjectives) ||
+                           (!dominatesObjectives(particle.bestObjectives, particle.objectives) && dist(rng) < 0.5);
+            if (!replace) continue;
+            particle.bestGenome = particle.genome;
+            particle.bestObjectives = particle.objectives;
+        }
+        telemetry.lap(&GenerationTelemetry<objectiveCount>::selectionSeconds);
+        if (telemetry.enabled() || generationObserver) {
+            Leaders current = archive->snapshot();
+            telemetry.publish(gen + 1, current, evaluationCount());
+            if (generationObserver) generationObserver(gen + 1, current);
+        }
+        completedGenerations = gen + 1;
+    }
+    return archive->snapshot();
+}
+
+#endif // MOPSO_ENGINE_HPP
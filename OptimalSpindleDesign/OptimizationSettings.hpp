@@ -0,0 +1,72 @@
+#ifndef OPTIMIZATION_SETTINGS_HPP
+#define OPTIMIZATION_SETTINGS_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+enum class InitializationMethod {
+    Random,          // Independent uniform sampling per gene (default)
+    LatinHypercube   // Maximin Latin hypercube for continuous genes, stratified categorical genes
+};
+
+enum class ParameterControl {
+    Fixed,           // crossoverAlpha, mutationEta and mutationRate stay constant (default)
+    SuccessHistory   // Sampled per offspring around a memory of values that produced surviving offspring
+};
+
+enum class SearchAlgorithm {
+    Nsga2,           // Genetic algorithm with memetic refinement and reference-point guidance
+    Gde3,            // Generalized differential evolution
+    Mopso,           // Multi-objective particle swarm guided by the Pareto archive
+    Portfolio        // All three concurrently, sharing one evaluator and one archive
+};
+
+struct OptimizationSettings {
+    SearchAlgorithm algorithm;
+    size_t archiveCapacity;       // Pareto archive size for MOPSO leaders and the portfolio front
+
+    // Initial population
+    InitializationMethod initialization;
+    int designCandidates;         // Latin hypercube designs scored by the maximin criterion
+    std::string warmStartPath;    // Front file whose configurations seed the initial population (empty = none)
+    std::string frontExportPath;  // Rank-1 front is written here after the run (empty = none)
+    std::string metricsExportPath; // Per-generation front metrics, JSON for ".json" paths and CSV otherwise (empty = none)
+
+    // Variation operators
+    ParameterControl parameterControl;
+    double crossoverAlpha;        // BLX-α expansion (initial memory value when adaptive)
+    double mutationEta;           // Polynomial mutation distribution index (initial memory value when adaptive)
+    double mutationRate;          // Per-gene mutation probability (initial memory value when adaptive)
+    int adaptationMemory;         // Success-history slots, each updated from one generation's successful offspring
+    double differentialWeight;    // GDE3 scale factor F applied to the difference vector
+    double differentialCrossover; // GDE3 crossover rate CR
+
+    // Memetic local search on the rank-1 front
+    int memeticInterval;          // Run the local search every K generations (0 disables it)
+    int memeticCandidates;        // Number of rank-1 individuals refined per memetic stage
+    int memeticEvaluationBudget;  // Fresh (uncached) evaluations allowed per refined individual
+    double memeticInitialStep;    // Initial pattern step as a fraction of each gene's range
+    double memeticMinimumStep;    // Pattern search stops once the step shrinks below this fraction
+
+    size_t workerThreads;         // Dedicated evaluation pool size (0 = the shared work-stealing executor)
+    size_t evaluationCacheCapacity; // Genomes memoized per evaluator, least recently used evicted first (0 = no cache)
+    double timeLimitSeconds;      // Stop after this wall-clock time and keep the best front so far (0 = no limit)
+
+    // Reference-point guidance (R-NSGA-II); each point is {vibration mm/s, bearing life h, temperature rise °C}
+    std::vector<std::vector<double>> referencePoints;  // Empty = plain crowding-distance selection
+    double referenceEpsilon;      // Normalized clearing radius that keeps solutions around a reference point apart
+
+    // Default constructor
+    OptimizationSettings()
+        : algorithm(SearchAlgorithm::Nsga2), archiveCapacity(200),
+          initialization(InitializationMethod::Random), designCandidates(20),
+          parameterControl(ParameterControl::Fixed), crossoverAlpha(0.5), mutationEta(20.0), mutationRate(0.1),
+          adaptationMemory(5), differentialWeight(0.5), differentialCrossover(0.3),
+          memeticInterval(5), memeticCandidates(4), memeticEvaluationBudget(40),
+          memeticInitialStep(0.1), memeticMinimumStep(0.005), workerThreads(0), evaluationCacheCapacity(65536),
+          timeLimitSeconds(0.0),
+          referenceEpsilon(0.01) {}
+};
+
+#endif // OPTIMIZATION_SETTINGS_HPP
@@ -0,0 +1,153 @@
+#ifndef PARALLEL_EVALUATOR_HPP
+#define PARALLEL_EVALUATOR_HPP
+
+#include "MogaProblem.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <functional>
+#include <future>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Evaluation backend shared by the search engines: a thread pool, a quantized evaluation cache and an evaluation counter.
+// Several engines may share one evaluator, in which case they also share its cache and its count. The cache holds at
+// most cacheCapacity genomes and evicts the least recently used one, so its memory stays fixed however long the
+// evaluator lives. With no thread count the evaluator submits to the process-wide work-stealing executor instead of
+// owning a pool.
+template<MogaProblem Problem>
+class ParallelEvaluator {
+public:
+    using GenomeType = Genome<Problem::continuousGenes, Problem::categoricalGenes>;
+    using Objectives = std::array<double, Problem::objectiveCount>;
+    using CacheKey = std::array<long long, Problem::continuousGenes + Problem::categoricalGenes>;
+
+    struct CacheKeyHash {
+        size_t operator()(const CacheKey& key) const {
+            size_t hash = 1469598103934665603ull;
+            for (long long value : key) {
+                hash ^= std::hash<long long>{}(value) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+            }
+            return hash;
+        }
+    };
+
+private:
+    const Problem& problem;
+    std::unique_ptr<ThreadPool> ownedWorkers;
+    ThreadPool* workers;   // ownedWorkers, or ThreadPool::shared()
+    // Memoizes objectives so repeated local moves cost nothing; recency runs from the front of the list to the back
+    using CacheEntry = std::pair<CacheKey, Objectives>;
+    std::list<CacheEntry> recency;
+    std::unordered_map<CacheKey, typename std::list<CacheEntry>::iterator, CacheKeyHash> cache;
+    size_t cacheCapacity;
+    std::mutex cacheMutex;
+    std::atomic<size_t> evaluations;
+
+public:
+    static constexpr size_t defaultCacheCapacity = 65536;
+
+    ParallelEvaluator(const Problem& problem, size_t threadCount, size_t cacheCapacity = defaultCacheCapacity)
+        : problem(problem), ownedWorkers(threadCount > 0 ? std::make_unique<ThreadPool>(threadCount) : nullptr),
+          workers(ownedWorkers ? ownedWorkers.get() : &ThreadPool::shared()), cacheCapacity(cacheCapacity), evaluations(0) {
+        cache.reserve(std::min<size_t>(cacheCapacity, defaultCacheCapacity));
+    }
+
+    ParallelEvaluator(const ParallelEvaluator&) = delete;
+    ParallelEvaluator& operator=(const ParallelEvaluator&) = delete;
+
+    ThreadPool& pool() { return *workers; }
+    size_t evaluationCount() const { return evaluations.load(); }
+    size_t cacheSize() {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        return cache.size();
+    }
+
+    static CacheKey makeCacheKey(const GenomeType& genome) {
+        // Continuous genes are quantized to 1e-4 of their range so that near-identical moves share an entry
+        CacheKey key{};
+        for (size_t i = 0; i < Problem::continuousGenes; ++i) key[i] = std::llround(genome.continuous[i] * 10000.0);
+        for (size_t i = 0; i < Problem::categoricalGenes; ++i) key[Problem::continuousGenes + i] = genome.categorical[i];
+        return key;
+    }
+
+    bool lookup(const GenomeType& genome, Objectives& objectives) {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = cache.find(makeCacheKey(genome));
+        if (it == cache.end()) return false;
+        recency.splice(recency.begin(), recency, it->second);
+        objectives = it->second->second;
+        return true;
+    }
+
+    void store(const GenomeType& genome, const Objectives& objectives) {
+        if (cacheCapacity == 0) return;
+        CacheKey key = makeCacheKey(genome);
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            recency.splice(recency.begin(), recency, it->second);
+            return;
+        }
+        if (cache.size() >= cacheCapacity) {
+            cache.erase(recency.back().first);
+            recency.pop_back();
+        }
+        recency.emplace_front(key, objectives);
+        cache.emplace(key, recency.begin());
+    }
+
+    // Evaluates on the calling thread and caches the result; a throwing problem gets worst-case objectives
+    void evaluate(const GenomeType& genome, Objectives& objectives, std::mt19937& generator) {
+        try {
+            problem.evaluate(genome, objectives, generator);
+        } catch (const std::exception&) {
+            objectives.fill(std::numeric_limits<double>::max()); // Worst case keeps a failed evaluation from propagating
+        }
+        evaluations.fetch_add(1, std::memory_order_relaxed);
+        store(genome, objectives);
+    }
+
+    // Evaluates every item (anything with genome and objectives members) on the pool and waits for all of them.
+    // Each task gets its own generator, seeded here from seedSource so runs stay reproducible. Once control reports a
+    // stop, tasks that have not started yet skip their evaluation and no further ones are submitted; the items left
+    // unevaluated are then removed, so every remaining item carries objectives. Returns false if that happened.
+    template<typename Item>
+    bool evaluateBatch(std::vector<Item>& items, std::mt19937& seedSource, const SearchControl& control = SearchControl()) {
+        std::uniform_int_distribution<unsigned int> seedDist;
+        std::vector<std::future<void>> pending;
+        std::vector<char> evaluated(items.size(), 0);
+        pending.reserve(items.size());
+        for (size_t i = 0; i < items.size() && !control.stopRequested(); ++i) {
+            unsigned int seed = seedDist(seedSource);
+            pending.push_back(workers->submit([this, &item = items[i], &done = evaluated[i], &control, seed]() {
+                if (control.stopRequested()) return;
+                std::mt19937 generator(seed);
+                evaluate(item.genome, item.objectives, generator);
+                done = 1;
+            }));
+        }
+        for (auto& evaluation : pending) workers->wait(evaluation);
+
+        size_t kept = 0;
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (!evaluated[i]) continue;
+            if (kept != i) items[kept] = std::move(items[i]);
+            ++kept;
+        }
+        if (kept == items.size()) return true;
+        items.erase(items.begin() + kept, items.end());
+        return false;
+    }
+};
+
+#endif // PARALLEL_EVALUATOR_HPP
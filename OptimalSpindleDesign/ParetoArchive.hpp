@@ -0,0 +1,79 @@
+#ifndef PARETO_ARCHIVE_HPP
+#define PARETO_ARCHIVE_HPP
+
+#include "MogaProblem.hpp"
+#include "ParetoRanking.hpp"
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <vector>
+
+// Thread-safe bounded archive of mutually non-dominated solutions. Engines feed it after every evaluation batch;
+// when it overflows, the most crowded member is dropped.
+template<MogaProblem Problem>
+class ParetoArchive {
+public:
+    using GenomeType = Genome<Problem::continuousGenes, Problem::categoricalGenes>;
+    using Objectives = std::array<double, Problem::objectiveCount>;
+
+    struct Entry {
+        GenomeType genome;
+        Objectives objectives{};
+        int source = 0; // Tag of the engine that found the entry
+    };
+
+private:
+    std::vector<Entry> entries;
+    size_t capacity;
+    mutable std::mutex mutex;
+
+    void prune() {
+        while (entries.size() > capacity) {
+            std::vector<Objectives> objectives;
+            std::vector<size_t> front(entries.size());
+            for (size_t i = 0; i < entries.size(); ++i) {
+                objectives.push_back(entries[i].objectives);
+                front[i] = i;
+            }
+            std::vector<double> crowding = crowdingDistances(objectives, front);
+            entries.erase(entries.begin() + (std::min_element(crowding.begin(), crowding.end()) - crowding.begin()));
+        }
+    }
+
+public:
+    explicit ParetoArchive(size_t capacity = 200) : capacity(std::max<size_t>(2, capacity)) {}
+
+    ParetoArchive(const ParetoArchive&) = delete;
+    ParetoArchive& operator=(const ParetoArchive&) = delete;
+
+    // Returns true when the solution entered the archive (it was neither dominated nor a duplicate)
+    bool insert(const GenomeType& genome, const Objectives& objectives, int source = 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& entry : entries) {
+            if (entry.objectives == objectives || dominatesObjectives(entry.objectives, objectives)) return false;
+        }
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [&](const Entry& entry) {
+            return dominatesObjectives(objectives, entry.objectives);
+        }), entries.end());
+        entries.push_back({genome, objectives, source});
+        prune();
+        return true;
+    }
+
+    template<typename Item>
+    void insertAll(const std::vector<Item>& items, int source = 0) {
+        for (const auto& item : items) insert(item.genome, item.objectives, source);
+    }
+
+    std::vector<Entry> snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return entries;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return entries.size();
+    }
+};
+
+#endif // PARETO_ARCHIVE_HPP
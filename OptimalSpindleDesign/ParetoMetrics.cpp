@@ -0,0 +1,336 @@
+#include "ParetoMetrics.hpp"
+#include "KdTree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+// IGD+ distance d+(z, a): the squared amount by which approximation point a is worse than reference point z
+struct DominanceDistanceMetric {
+    static double distance(const std::vector<double>& query, const std::vector<double>& point) {
+        double sum = 0.0;
+        for (size_t i = 0; i < query.size(); ++i) {
+            double excess = std::max(point[i] - query[i], 0.0);
+            sum += excess * excess;
+        }
+        return sum;
+    }
+    static double lowerBound(const std::vector<double>& query, const std::vector<double>& lower, const std::vector<double>&) {
+        return distance(query, lower);
+    }
+};
+
+// Shift needed for the point to weakly dominate the query; non-positive means the query is attained
+struct EpsilonMetric {
+    static double distance(const std::vector<double>& query, const std::vector<double>& point) {
+        double shift = -std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < query.size(); ++i) shift = std::max(shift, point[i] - query[i]);
+        return shift;
+    }
+    static double lowerBound(const std::vector<double>& query, const std::vector<double>& lower, const std::vector<double>&) {
+        return distance(query, lower);
+    }
+};
+
+std::string formatValue(double value, bool json) {
+    if (!std::isfinite(value)) return json ? "null" : (std::isnan(value) ? "nan" : "inf");
+    std::ostringstream out;
+    out << std::setprecision(10) << value;
+    return out.str();
+}
+
+bool dominatesPoint(const std::vector<double>& a, const std::vector<double>& b) {
+    bool better = false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] > b[i]) return false;
+        if (a[i] < b[i]) better = true;
+    }
+    return better;
+}
+
+// Hypervolume by slicing along the last objective (HSO); the two-objective base case is a sweep
+double slicedHypervolume(PointSet points, const std::vector<double>& referencePoint, size_t dimensions) {
+    if (points.empty()) return 0.0;
+    if (dimensions == 1) {
+        double best = referencePoint[0];
+        for (const auto& point : points) best = std::min(best, point[0]);
+        return referencePoint[0] - best;
+    }
+    if (dimensions == 2) {
+        std::sort(points.begin(), points.end(), [](const std::vector<double>& a, const std::vector<double>& b) {
+            return a[0] < b[0] || (a[0] == b[0] && a[1] < b[1]);
+        });
+        double area = 0.0;
+        double ceiling = referencePoint[1];
+        for (const auto& point : points) {
+            if (point[1] >= ceiling) continue;
+            area += (referencePoint[0] - point[0]) * (ceiling - point[1]);
+            ceiling = point[1];
+        }
+        return area;
+    }
+
+    size_t last = dimensions - 1;
+    std::sort(points.begin(), points.end(), [last](const std::vector<double>& a, const std::vector<double>& b) {
+        return a[last] < b[last];
+    });
+    double volume = 0.0;
+    PointSet slice;
+    for (size_t i = 0; i < points.size(); ++i) {
+        // Points with a worse last objective never dominate inside the slice, so only keep the non-dominated projection
+        std::vector<double> projected(points[i].begin(), points[i].begin() + last);
+        bool dominated = false;
+        for (const auto& kept : slice) {
+            if (std::equal(kept.begin(), kept.end(), projected.begin(), [](double a, double b) { return a <= b; })) {
+                dominated = true;
+                break;
+            }
+        }
+        if (!dominated) {
+            slice.erase(std::remove_if(slice.begin(), slice.end(), [&](const std::vector<double>& kept) {
+                return dominatesPoint(projected, kept);
+            }), slice.end());
+            slice.push_back(projected);
+        }
+        double upper = (i + 1 < points.size()) ? points[i + 1][last] : referencePoint[last];
+        double depth = upper - points[i][last];
+        if (depth > 0.0) volume += depth * slicedHypervolume(slice, referencePoint, last);
+    }
+    return volume;
+}
+}
+
+PointSet nonDominatedFilter(const PointSet& points) {
+    // Lexicographic order puts every point after the points that dominate it and duplicates side by side; the stable
+    // sort keeps the first copy of each duplicate first
+    std::vector<size_t> order(points.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return points[a] < points[b]; });
+    std::vector<size_t> distinct;
+    for (size_t i : order) {
+        if (distinct.empty() || points[distinct.back()] != points[i]) distinct.push_back(i);
+    }
+
+    std::vector<char> keep(points.size(), 0);
+    if (!distinct.empty() && points[distinct.front()].size() <= 2) {
+        // Sweep: a point survives when its second objective beats every point before it
+        double lowest = std::numeric_limits<double>::infinity();
+        for (size_t i : distinct) {
+            double second = points[i].size() == 2 ? points[i][1] : 0.0;
+            if (second < lowest) {
+                keep[i] = 1;
+                lowest = second;
+            }
+        }
+    } else if (!distinct.empty()) {
+        // A distinct point is dominated exactly when some other point weakly dominates it, i.e. needs no positive shift
+        PointSet unique;
+        unique.reserve(distinct.size());
+        for (size_t i : distinct) unique.push_back(points[i]);
+        KdTree<EpsilonMetric> tree(unique);
+        for (size_t k = 0; k < unique.size(); ++k) {
+            if (tree.nearest(unique[k], k).second > 0.0) keep[distinct[k]] = 1;
+        }
+    }
+
+    PointSet front;
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (keep[i]) front.push_back(points[i]);
+    }
+    return front;
+}
+
+PointSet normalizePoints(const PointSet& points, const std::vector<double>& ideal, const std::vector<double>& nadir) {
+    PointSet normalized = points;
+    for (auto& point : normalized) {
+        for (size_t i = 0; i < point.size(); ++i) {
+            double range = nadir[i] - ideal[i] > 1e-12 ? nadir[i] - ideal[i] : 1.0; // A collapsed objective is only shifted
+            point[i] = (point[i] - ideal[i]) / range;
+        }
+    }
+    return normalized;
+}
+
+double hypervolume(const PointSet& front, const std::vector<double>& referencePoint) {
+    PointSet inside;
+    for (const auto& point : front) {
+        if (point.size() != referencePoint.size()) {
+            throw std::invalid_argument("Point and reference point dimensions differ");
+        }
+        bool bounded = true;
+        for (size_t i = 0; i < point.size(); ++i) {
+            if (point[i] >= referencePoint[i]) bounded = false;
+        }
+        if (bounded) inside.push_back(point);
+    }
+    return slicedHypervolume(nonDominatedFilter(inside), referencePoint, referencePoint.size());
+}
+
+double invertedGenerationalDistance(const PointSet& approximation, const PointSet& referenceFront) {
+    if (approximation.empty() || referenceFront.empty()) return std::numeric_limits<double>::infinity();
+    KdTree<EuclideanMetric> tree(approximation);
+    double total = 0.0;
+    for (const auto& reference : referenceFront) total += std::sqrt(tree.nearest(reference).second);
+    return total / referenceFront.size();
+}
+
+double invertedGenerationalDistancePlus(const PointSet& approximation, const PointSet& referenceFront) {
+    if (approximation.empty() || referenceFront.empty()) return std::numeric_limits<double>::infinity();
+    KdTree<DominanceDistanceMetric> tree(approximation);
+    double total = 0.0;
+    for (const auto& reference : referenceFront) total += std::sqrt(tree.nearest(reference).second);
+    return total / referenceFront.size();
+}
+
+double additiveEpsilon(const PointSet& approximation, const PointSet& referenceFront) {
+    if (approximation.empty() || referenceFront.empty()) return std::numeric_limits<double>::infinity();
+    KdTree<EpsilonMetric> tree(approximation);
+    double epsilon = -std::numeric_limits<double>::infinity();
+    for (const auto& reference : referenceFront) epsilon = std::max(epsilon, tree.nearest(reference).second);
+    return epsilon;
+}
+
+double spacing(const PointSet& front) {
+    if (front.size() < 2) return 0.0;
+    KdTree<ManhattanMetric> tree(front);
+    std::vector<double> distances(front.size());
+    for (size_t i = 0; i < front.size(); ++i) distances[i] = tree.nearest(front[i], i).second;
+    double mean = 0.0;
+    for (double distance : distances) mean += distance / distances.size();
+    double sum = 0.0;
+    for (double distance : distances) sum += (distance - mean) * (distance - mean);
+    return std::sqrt(sum / (distances.size() - 1));
+}
+
+double generalizedSpread(const PointSet& front, const PointSet& referenceFront) {
+    if (front.size() < 2 || referenceFront.empty()) return 1.0;
+    KdTree<EuclideanMetric> tree(front);
+
+    // Extreme reference points: the largest value along each objective
+    double extremeDistance = 0.0;
+    for (size_t m = 0; m < referenceFront[0].size(); ++m) {
+        auto extreme = std::max_element(referenceFront.begin(), referenceFront.end(), [m](const std::vector<double>& a, const std::vector<double>& b) {
+            return a[m] < b[m];
+        });
+        extremeDistance += std::sqrt(tree.nearest(*extreme).second);
+    }
+
+    std::vector<double> distances(front.size());
+    double mean = 0.0;
+    for (size_t i = 0; i < front.size(); ++i) {
+        distances[i] = std::sqrt(tree.nearest(front[i], i).second);
+        mean += distances[i] / front.size();
+    }
+    double deviation = 0.0;
+    for (double distance : distances) deviation += std::abs(distance - mean);
+    double denominator = extremeDistance + front.size() * mean;
+    return denominator > 0.0 ? (extremeDistance + deviation) / denominator : 0.0;
+}
+
+PointSet attainmentSurface(const std::vector<PointSet>& runs, size_t level) {
+    if (runs.empty() || level == 0 || level > runs.size()) {
+        throw std::invalid_argument("Attainment level must be between 1 and the number of runs");
+    }
+    size_t dimensions = 0;
+    for (const auto& run : runs) {
+        if (!run.empty()) dimensions = run[0].size();
+    }
+    PointSet surface;
+    if (dimensions == 2) {
+        // Sweep x over every coordinate; each run attains the lowest y among its points left of x
+        std::vector<PointSet> staircases;
+        std::vector<double> xs;
+        for (const auto& run : runs) {
+            PointSet staircase = nonDominatedFilter(run);
+            std::sort(staircase.begin(), staircase.end());
+            staircases.push_back(staircase);
+            for (const auto& point : staircase) xs.push_back(point[0]);
+        }
+        std::sort(xs.begin(), xs.end());
+        xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+        std::vector<size_t> cursor(runs.size(), 0);
+        std::vector<double> best(runs.size(), std::numeric_limits<double>::infinity());
+        for (double x : xs) {
+            for (size_t r = 0; r < staircases.size(); ++r) {
+                while (cursor[r] < staircases[r].size() && staircases[r][cursor[r]][0] <= x) {
+                    best[r] = std::min(best[r], staircases[r][cursor[r]][1]);
+                    ++cursor[r];
+                }
+            }
+            std::vector<double> attained = best;
+            std::nth_element(attained.begin(), attained.begin() + (level - 1), attained.end());
+            if (std::isfinite(attained[level - 1])) surface.push_back({x, attained[level - 1]});
+        }
+        return nonDominatedFilter(surface);
+    }
+
+    std::vector<KdTree<EpsilonMetric>> trees;
+    PointSet candidates;
+    for (const auto& run : runs) {
+        trees.emplace_back(run);
+        candidates.insert(candidates.end(), run.begin(), run.end());
+    }
+    for (const auto& candidate : candidates) {
+        size_t count = 0;
+        for (const auto& tree : trees) {
+            if (tree.size() > 0 && tree.nearest(candidate).second <= 0.0) ++count;
+        }
+        if (count >= level) surface.push_back(candidate);
+    }
+    return nonDominatedFilter(surface);
+}
+
+FrontMetrics computeFrontMetrics(const PointSet& front, const PointSet& referenceFront, const std::vector<double>& hypervolumeReference,
+                                 int generation) {
+    FrontMetrics metrics;
+    metrics.generation = generation;
+    metrics.points = front.size();
+    metrics.hypervolume = hypervolume(front, hypervolumeReference);
+    metrics.igd = invertedGenerationalDistance(front, referenceFront);
+    metrics.igdPlus = invertedGenerationalDistancePlus(front, referenceFront);
+    metrics.epsilon = additiveEpsilon(front, referenceFront);
+    metrics.spacing = spacing(front);
+    metrics.spread = generalizedSpread(front, referenceFront);
+    return metrics;
+}
+
+std::string frontMetricsToCsv(const std::vector<FrontMetrics>& records) {
+    std::ostringstream out;
+    out << "generation,points,hypervolume,igd,igd_plus,epsilon,spacing,spread\n";
+    for (const auto& record : records) {
+        out << record.generation << "," << record.points << ","
+            << formatValue(record.hypervolume, false) << "," << formatValue(record.igd, false) << ","
+            << formatValue(record.igdPlus, false) << "," << formatValue(record.epsilon, false) << ","
+            << formatValue(record.spacing, false) << "," << formatValue(record.spread, false) << "\n";
+    }
+    return out.str();
+}
+
+std::string frontMetricsToJson(const std::vector<FrontMetrics>& records) {
+    std::ostringstream out;
+    out << "[\n";
+    for (size_t i = 0; i < records.size(); ++i) {
+        const auto& record = records[i];
+        out << "  {\"generation\": " << record.generation << ", \"points\": " << record.points
+            << ", \"hypervolume\": " << formatValue(record.hypervolume, true) << ", \"igd\": " << formatValue(record.igd, true)
+            << ", \"igd_plus\": " << formatValue(record.igdPlus, true) << ", \"epsilon\": " << formatValue(record.epsilon, true)
+            << ", \"spacing\": " << formatValue(record.spacing, true) << ", \"spread\": " << formatValue(record.spread, true) << "}"
+            << (i + 1 < records.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+    return out.str();
+}
+
+void writeFrontMetrics(const std::string& path, const std::vector<FrontMetrics>& records) {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot write metrics file: " + path);
+    }
+    bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+    file << (json ? frontMetricsToJson(records) : frontMetricsToCsv(records));
+}
@@ -0,0 +1,61 @@
+#ifndef PARETO_METRICS_HPP
+#define PARETO_METRICS_HPP
+
+#include <string>
+#include <vector>
+
+// Objective vectors are minimized; a point set is any collection of them (front, archive, reference front)
+using PointSet = std::vector<std::vector<double>>;
+
+// Non-dominated points in input order, keeping the first copy of duplicates. O(n log n) for two objectives; with more,
+// each point is one dominance query against a kd-tree over the set
+PointSet nonDominatedFilter(const PointSet& points);
+
+// Maps every point onto [0, 1] per objective using the given ideal and nadir vectors
+PointSet normalizePoints(const PointSet& points, const std::vector<double>& ideal, const std::vector<double>& nadir);
+
+// Exact hypervolume dominated by the front and bounded by the reference point
+double hypervolume(const PointSet& front, const std::vector<double>& referencePoint);
+
+// Mean Euclidean distance from each reference point to its nearest approximation point
+double invertedGenerationalDistance(const PointSet& approximation, const PointSet& referenceFront);
+
+// IGD+: like IGD, but only the amount by which an approximation point is worse than the reference point counts
+double invertedGenerationalDistancePlus(const PointSet& approximation, const PointSet& referenceFront);
+
+// Smallest shift that lets the approximation weakly dominate every reference point (additive epsilon indicator)
+double additiveEpsilon(const PointSet& approximation, const PointSet& referenceFront);
+
+// Schott's spacing: standard deviation of nearest-neighbour Manhattan distances within the front (0 = evenly spaced)
+double spacing(const PointSet& front);
+
+// Generalized spread (Zhou et al.): 0 for an evenly distributed front that reaches the extremes of the reference front
+double generalizedSpread(const PointSet& front, const PointSet& referenceFront);
+
+// Non-dominated points attained by at least `level` of the runs. Exact for two objectives; with more objectives the
+// surface is evaluated at the union of the run points
+PointSet attainmentSurface(const std::vector<PointSet>& runs, size_t level);
+
+struct FrontMetrics {
+    int generation = 0;
+    size_t points = 0;
+    double hypervolume = 0.0;
+    double igd = 0.0;
+    double igdPlus = 0.0;
+    double epsilon = 0.0;
+    double spacing = 0.0;
+    double spread = 0.0;
+};
+
+// Every indicator of one front against a reference front; the hypervolume is bounded by hypervolumeReference
+FrontMetrics computeFrontMetrics(const PointSet& front, const PointSet& referenceFront, const std::vector<double>& hypervolumeReference,
+                                 int generation = 0);
+
+// One record per line after a header row / a JSON array of objects (non-finite values become null)
+std::string frontMetricsToCsv(const std::vector<FrontMetrics>& records);
+std::string frontMetricsToJson(const std::vector<FrontMetrics>& records);
+
+// Writes JSON when the path ends in ".json" and CSV otherwise
+void writeFrontMetrics(const std::string& path, const std::vector<FrontMetrics>& records);
+
+#endif // PARETO_METRICS_HPP
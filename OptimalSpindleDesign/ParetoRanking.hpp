@@ -0,0 +1,84 @@
+#ifndef PARETO_RANKING_HPP
+#define PARETO_RANKING_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Dominance, non-dominated sorting and crowding on fixed-size objective vectors, shared by every search engine
+
+using Fronts = std::vector<std::vector<size_t>>;
+
+template<std::size_t M>
+bool dominatesObjectives(const std::array<double, M>& a, const std::array<double, M>& b) {
+    // Folded over the compile-time objective count so the comparison fully unrolls
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+        bool noWorse = ((a[I] <= b[I]) && ...);
+        bool better = ((a[I] < b[I]) || ...);
+        return noWorse && better;
+    }(std::make_index_sequence<M>{});
+}
+
+// Fast non-dominated sort (Deb et al.); fronts hold indices into the input, best front first
+template<std::size_t M>
+Fronts sortNonDominated(const std::vector<std::array<double, M>>& objectives) {
+    Fronts fronts;
+    std::vector<int> dominationCount(objectives.size(), 0);
+    std::vector<std::vector<size_t>> dominatedBy(objectives.size());
+    for (size_t i = 0; i < objectives.size(); ++i) {
+        for (size_t j = i + 1; j < objectives.size(); ++j) {
+            if (dominatesObjectives(objectives[i], objectives[j])) {
+                dominatedBy[i].push_back(j);
+                dominationCount[j]++;
+            } else if (dominatesObjectives(objectives[j], objectives[i])) {
+                dominatedBy[j].push_back(i);
+                dominationCount[i]++;
+            }
+        }
+    }
+    std::vector<size_t> current;
+    for (size_t i = 0; i < objectives.size(); ++i) {
+        if (dominationCount[i] == 0) current.push_back(i);
+    }
+    while (!current.empty()) {
+        std::vector<size_t> next;
+        for (size_t i : current) {
+            for (size_t j : dominatedBy[i]) {
+                if (--dominationCount[j] == 0) next.push_back(j);
+            }
+        }
+        fronts.push_back(std::move(current));
+        current = std::move(next);
+    }
+    return fronts;
+}
+
+// Crowding distance of each front member, aligned with the front; boundary points and fronts of two or fewer are infinite
+template<std::size_t M>
+std::vector<double> crowdingDistances(const std::vector<std::array<double, M>>& objectives, const std::vector<size_t>& front) {
+    std::vector<double> distances(front.size(), 0.0);
+    if (front.size() <= 2) {
+        std::fill(distances.begin(), distances.end(), std::numeric_limits<double>::infinity());
+        return distances;
+    }
+    std::vector<size_t> order(front.size());
+    for (size_t objIdx = 0; objIdx < M; ++objIdx) {
+        for (size_t k = 0; k < order.size(); ++k) order[k] = k;
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return objectives[front[a]][objIdx] < objectives[front[b]][objIdx];
+        });
+        distances[order.front()] = std::numeric_limits<double>::infinity();
+        distances[order.back()] = std::numeric_limits<double>::infinity();
+        double objRange = objectives[front[order.back()]][objIdx] - objectives[front[order.front()]][objIdx];
+        if (std::abs(objRange) < 1e-10) continue; // Skip if range is effectively zero
+        for (size_t k = 1; k + 1 < order.size(); ++k) {
+            distances[order[k]] += (objectives[front[order[k + 1]]][objIdx] - objectives[front[order[k - 1]]][objIdx]) / objRange;
+        }
+    }
+    return distances;
+}
+
+#endif // PARETO_RANKING_HPP
@@ -0,0 +1,105 @@
+#include "ReplicateJob.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return "";
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+double parseNumber(const std::string& value, const std::string& key) {
+    size_t used = 0;
+    double number = 0.0;
+    try {
+        number = std::stod(value, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != value.size()) {
+        throw std::invalid_argument("Invalid number for " + key + ": " + value);
+    }
+    return number;
+}
+}
+
+ReplicateJob loadReplicateJob(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open job file: " + path);
+    }
+
+    ReplicateJob job;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+        size_t separator = line.find('=');
+        if (separator == std::string::npos) {
+            throw std::invalid_argument("Line " + std::to_string(lineNumber) + " is not of the form key = value");
+        }
+        std::string key = trim(line.substr(0, separator));
+        std::string value = trim(line.substr(separator + 1));
+
+        if (key == "duration") job.duration = parseNumber(value, key);
+        else if (key == "load_factor") job.loadFactor = parseNumber(value, key);
+        else if (key == "population") job.populationSize = static_cast<int>(parseNumber(value, key));
+        else if (key == "generations") job.generations = static_cast<int>(parseNumber(value, key));
+        else if (key == "replicates") job.replicates = static_cast<int>(parseNumber(value, key));
+        else if (key == "seed") job.baseSeed = static_cast<unsigned int>(parseNumber(value, key));
+        else if (key == "concurrent_runs") job.concurrentRuns = static_cast<size_t>(parseNumber(value, key));
+        else if (key == "merged_front") job.mergedFrontPath = value;
+        else if (key == "warm_start") job.settings.warmStartPath = value;
+        else if (key == "memetic_interval") job.settings.memeticInterval = static_cast<int>(parseNumber(value, key));
+        else if (key == "worker_threads") job.settings.workerThreads = static_cast<size_t>(parseNumber(value, key));
+        else if (key == "evaluation_cache") job.settings.evaluationCacheCapacity = static_cast<size_t>(parseNumber(value, key));
+        else if (key == "reference_epsilon") job.settings.referenceEpsilon = parseNumber(value, key);
+        else if (key == "time_limit") job.settings.timeLimitSeconds = parseNumber(value, key);
+        else if (key == "algorithm") {
+            if (value == "nsga2") job.settings.algorithm = SearchAlgorithm::Nsga2;
+            else if (value == "gde3") job.settings.algorithm = SearchAlgorithm::Gde3;
+            else if (value == "mopso") job.settings.algorithm = SearchAlgorithm::Mopso;
+            else if (value == "portfolio") job.settings.algorithm = SearchAlgorithm::Portfolio;
+            else throw std::invalid_argument("Algorithm must be nsga2, gde3, mopso or portfolio");
+        } else if (key == "initialization") {
+            if (value == "random") job.settings.initialization = InitializationMethod::Random;
+            else if (value == "lhs") job.settings.initialization = InitializationMethod::LatinHypercube;
+            else throw std::invalid_argument("Initialization must be random or lhs");
+        } else if (key == "parameter_control") {
+            if (value == "fixed") job.settings.parameterControl = ParameterControl::Fixed;
+            else if (value == "success_history") job.settings.parameterControl = ParameterControl::SuccessHistory;
+            else throw std::invalid_argument("Parameter control must be fixed or success_history");
+        } else if (key == "reference_point") {
+            std::vector<double> point;
+            std::stringstream fields(value);
+            std::string field;
+            while (std::getline(fields, field, ',')) point.push_back(parseNumber(trim(field), key));
+            if (point.size() != 3) {
+                throw std::invalid_argument("reference_point needs vibration, bearing life and temperature rise");
+            }
+            job.settings.referencePoints.push_back(point);
+        } else {
+            throw std::invalid_argument("Unknown key on line " + std::to_string(lineNumber) + ": " + key);
+        }
+    }
+
+    if (job.duration <= 0.0) {
+        throw std::invalid_argument("Duration must be positive");
+    }
+    if (job.loadFactor < 0.5 || job.loadFactor > 2.0) {
+        throw std::invalid_argument("Load factor must be between 0.5 and 2.0");
+    }
+    if (job.settings.timeLimitSeconds < 0.0) {
+        throw std::invalid_argument("Time limit must not be negative");
+    }
+    if (job.populationSize < 10 || job.generations < 1 || job.replicates < 1) {
+        throw std::invalid_argument("Population must be at least 10, generations and replicates at least 1");
+    }
+    return job;
+}
@@ -0,0 +1,32 @@
+#ifndef REPLICATE_JOB_HPP
+#define REPLICATE_JOB_HPP
+
+#include "OptimizationSettings.hpp"
+#include <string>
+
+// Replicate study: the same optimization repeated with consecutive seeds so results can be compared statistically
+struct ReplicateJob {
+    double duration;
+    double loadFactor;
+    int populationSize;
+    int generations;
+    int replicates;
+    unsigned int baseSeed;        // Replicate r runs with seed baseSeed + r
+    size_t concurrentRuns;        // Replicates executed at once (0 = hardware concurrency)
+    std::string mergedFrontPath;  // Non-dominated union of all replicate fronts (empty = none)
+    OptimizationSettings settings;
+
+    // Default constructor
+    ReplicateJob()
+        : duration(1.0), loadFactor(1.0), populationSize(50), generations(20), replicates(10), baseSeed(1),
+          concurrentRuns(0) {}
+};
+
+// Reads a job description of "key = value" lines; '#' starts a comment. Throws on unknown keys or bad values.
+//   duration, load_factor, population, generations, replicates, seed, concurrent_runs, merged_front,
+//   algorithm (nsga2 | gde3 | mopso | portfolio), time_limit (seconds per replicate),
+//   initialization (random | lhs), parameter_control (fixed | success_history), memetic_interval, worker_threads, evaluation_cache, warm_start,
+//   reference_point = vibration, bearing life, temperature rise (may repeat), reference_epsilon
+ReplicateJob loadReplicateJob(const std::string& path);
+
+#endif // REPLICATE_JOB_HPP
@@ -0,0 +1,254 @@
+#ifndef SEARCH_ALGORITHMS_HPP
+#define SEARCH_ALGORITHMS_HPP
+
+#include "Gde3Engine.hpp"
+#include "MogaEngine.hpp"
+#include "MopsoEngine.hpp"
+#include "OptimizationSettings.hpp"
+#include "ParallelEvaluator.hpp"
+#include "ParetoArchive.hpp"
+#include "Telemetry.hpp"
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// One entry point over the search engines so callers pick the algorithm per job through OptimizationSettings::algorithm
+
+template<MogaProblem Problem>
+struct SearchHooks {
+    using GenomeType = Genome<Problem::continuousGenes, Problem::categoricalGenes>;
+    using Objectives = std::array<double, Problem::objectiveCount>;
+
+    std::vector<GenomeType> seedGenomes;      // Warm-start genomes placed in every initial population
+    std::vector<Objectives> referencePoints;  // Guide NSGA-II only
+    std::function<void(EngineMessage, const std::string&)> messageSink;
+    std::function<void(int generation, const std::vector<Objectives>& front)> frontObserver; // Generation 0 is the initial front
+    TelemetrySink<Problem::objectiveCount> telemetrySink;  // Per-generation records, tagged with the reporting algorithm
+    SearchControl control;                    // Cancellation token and deadline
+    ParetoArchive<Problem>* archive = nullptr; // Fed during the run so other threads can snapshot the best-so-far front
+};
+
+enum class SearchStatus {
+    Completed,        // Every requested generation ran
+    Cancelled,        // The stop token was triggered
+    DeadlineReached   // The deadline passed first
+};
+
+template<MogaProblem Problem>
+struct SearchResult {
+    std::vector<typename ParetoArchive<Problem>::Entry> front;  // Non-dominated solutions; source is the SearchAlgorithm that found them
+    size_t evaluations = 0;
+    int generationsCompleted = 0;
+    SearchStatus status = SearchStatus::Completed;
+    std::vector<std::string> notes;  // Algorithm-specific summary lines for reports
+};
+
+inline std::string searchAlgorithmName(SearchAlgorithm algorithm) {
+    switch (algorithm) {
+        case SearchAlgorithm::Nsga2: return "NSGA-II";
+        case SearchAlgorithm::Gde3: return "GDE3";
+        case SearchAlgorithm::Mopso: return "MOPSO";
+        case SearchAlgorithm::Portfolio: return "Portfolio";
+    }
+    return "Unknown";
+}
+
+namespace search_detail {
+template<MogaProblem Problem, typename Population>
+std::vector<std::array<double, Problem::objectiveCount>> firstFrontObjectives(const Population& population) {
+    std::vector<std::array<double, Problem::objectiveCount>> front;
+    for (const auto& ind : population) {
+        if (ind.rank == 1) front.push_back(ind.objectives);
+    }
+    return front;
+}
+
+template<MogaProblem Problem, typename Population>
+void collectFirstFront(const Population& population, SearchAlgorithm source, SearchResult<Problem>& result) {
+    for (const auto& ind : population) {
+        if (ind.rank == 1) result.front.push_back({ind.genome, ind.objectives, static_cast<int>(source)});
+    }
+}
+
+// Runs one engine on the given evaluator; when archive is set the engine also feeds it, tagged with the algorithm
+template<MogaProblem Problem>
+SearchResult<Problem> runEngine(SearchAlgorithm algorithm, ParallelEvaluator<Problem>& evaluator, ParetoArchive<Problem>* archive,
+                                const OptimizationSettings& settings, unsigned int seed, int populationSize, int generations,
+                                const SearchHooks<Problem>& hooks) {
+    SearchResult<Problem> result;
+    int source = static_cast<int>(algorithm);
+    TelemetrySink<Problem::objectiveCount> telemetrySink;
+    if (hooks.telemetrySink) {
+        telemetrySink = [&hooks, source](const GenerationTelemetry<Problem::objectiveCount>& record) {
+            GenerationTelemetry<Problem::objectiveCount> tagged = record;
+            tagged.source = source;
+            hooks.telemetrySink(tagged);
+        };
+    }
+    if (algorithm == SearchAlgorithm::Nsga2) {
+        MogaEngine<Problem> engine(evaluator, settings, seed);
+        engine.setControl(hooks.control);
+        engine.setTelemetrySink(telemetrySink);
+        engine.setReferencePoints(hooks.referencePoints);
+        engine.setSeedGenomes(hooks.seedGenomes);
+        engine.setMessageSink(hooks.messageSink);
+        if (archive) engine.setArchive(archive, source);
+        if (hooks.frontObserver) {
+            engine.setGenerationObserver([&hooks](int generation, const typename MogaEngine<Problem>::Population& population) {
+                hooks.frontObserver(generation, firstFrontObjectives<Problem>(population));
+            });
+        }
+        collectFirstFront(engine.run(populationSize, generations), algorithm, result);
+        result.generationsCompleted = engine.generationsCompleted();
+        if (settings.memeticInterval > 0) {
+            result.notes.push_back("Memetic refinements accepted: " + std::to_string(engine.refinementsAccepted()));
+        }
+        if (settings.parameterControl == ParameterControl::SuccessHistory && !engine.adaptationHistory().empty()) {
+            const auto& adapted = engine.adaptationHistory().back();
+            std::ostringstream note;
+            note << std::fixed << std::setprecision(2) << "Adapted variation parameters: BLX-alpha " << adapted.alpha
+                 << ", polynomial eta " << adapted.eta << ", mutation rate " << adapted.mutationRate
+                 << " (categorical " << adapted.categoricalRate << ")";
+            result.notes.push_back(note.str());
+        }
+    } else if (algorithm == SearchAlgorithm::Gde3) {
+        Gde3Engine<Problem> engine(evaluator, settings, seed);
+        engine.setControl(hooks.control);
+        engine.setTelemetrySink(telemetrySink);
+        engine.setSeedGenomes(hooks.seedGenomes);
+        engine.setMessageSink(hooks.messageSink);
+        if (archive) engine.setArchive(archive, source);
+        if (hooks.frontObserver) {
+            engine.setGenerationObserver([&hooks](int generation, const typename Gde3Engine<Problem>::Population& population) {
+                hooks.frontObserver(generation, firstFrontObjectives<Problem>(population));
+            });
+        }
+        collectFirstFront(engine.run(populationSize, generations), algorithm, result);
+        result.generationsCompleted = engine.generationsCompleted();
+    } else if (algorithm == SearchAlgorithm::Mopso) {
+        MopsoEngine<Problem> engine(evaluator, settings, seed);
+        engine.setControl(hooks.control);
+        engine.setTelemetrySink(telemetrySink);
+        engine.setSeedGenomes(hooks.seedGenomes);
+        engine.setMessageSink(hooks.messageSink);
+        if (archive) engine.setArchive(archive, source);
+        if (hooks.frontObserver) {
+            engine.setGenerationObserver([&hooks](int generation, const typename MopsoEngine<Problem>::Leaders& leaders) {
+                std::vector<std::array<double, Problem::objectiveCount>> front;
+                for (const auto& leader : leaders) front.push_back(leader.objectives);
+                hooks.frontObserver(generation, front);
+            });
+        }
+        result.front = engine.run(populationSize, generations);
+        result.generationsCompleted = engine.generationsCompleted();
+    } else {
+        throw std::invalid_argument("runEngine expects a single algorithm");
+    }
+    if (result.generationsCompleted < generations) {
+        result.status = hooks.control.stopToken.stop_requested() ? SearchStatus::Cancelled : SearchStatus::DeadlineReached;
+    }
+    if (algorithm != SearchAlgorithm::Nsga2 && !hooks.referencePoints.empty()) {
+        result.notes.push_back("Reference points guide NSGA-II only and were ignored by " + searchAlgorithmName(algorithm));
+    }
+    return result;
+}
+
+// NSGA-II, GDE3 and MOPSO run concurrently on one evaluator (pool, cache, count) and one archive; the population is split
+// between them so the portfolio spends about the evaluations of a single run
+template<MogaProblem Problem>
+SearchResult<Problem> runPortfolio(const Problem& problem, const OptimizationSettings& settings, unsigned int seed,
+                                   int populationSize, int generations, const SearchHooks<Problem>& hooks) {
+    const SearchAlgorithm members[] = {SearchAlgorithm::Nsga2, SearchAlgorithm::Gde3, SearchAlgorithm::Mopso};
+    const int memberCount = static_cast<int>(std::size(members));
+    ParallelEvaluator<Problem> evaluator(problem, settings.workerThreads, settings.evaluationCacheCapacity);
+    ParetoArchive<Problem> ownedArchive(settings.archiveCapacity);
+    ParetoArchive<Problem>& archive = hooks.archive ? *hooks.archive : ownedArchive;
+    int memberPopulation = std::max(4, (populationSize + memberCount - 1) / memberCount);
+
+    // Engines report from their own threads; a generation's front is the archive once every member has finished it
+    std::mutex hookMutex;
+    std::vector<int> finished;
+    SearchHooks<Problem> memberHooks;
+    memberHooks.seedGenomes = hooks.seedGenomes;
+    memberHooks.referencePoints = hooks.referencePoints;
+    memberHooks.control = hooks.control;
+    if (hooks.messageSink) {
+        memberHooks.messageSink = [&hooks, &hookMutex](EngineMessage kind, const std::string& message) {
+            std::lock_guard<std::mutex> lock(hookMutex);
+            hooks.messageSink(kind, message);
+        };
+    }
+    if (hooks.telemetrySink) {
+        memberHooks.telemetrySink = [&hooks, &hookMutex](const GenerationTelemetry<Problem::objectiveCount>& record) {
+            std::lock_guard<std::mutex> lock(hookMutex);
+            hooks.telemetrySink(record);
+        };
+    }
+    if (hooks.frontObserver) {
+        memberHooks.frontObserver = [&](int generation, const std::vector<std::array<double, Problem::objectiveCount>>&) {
+            std::lock_guard<std::mutex> lock(hookMutex);
+            if (finished.size() <= static_cast<size_t>(generation)) finished.resize(generation + 1, 0);
+            if (++finished[generation] < memberCount) return;
+            std::vector<std::array<double, Problem::objectiveCount>> front;
+            for (const auto& entry : archive.snapshot()) front.push_back(entry.objectives);
+            hooks.frontObserver(generation, front);
+        };
+    }
+
+    std::mt19937 seeder(seed);
+    std::vector<std::future<SearchResult<Problem>>> runs;
+    for (SearchAlgorithm member : members) {
+        unsigned int memberSeed = seeder();
+        runs.push_back(std::async(std::launch::async, [&, member, memberSeed]() {
+            return runEngine(member, evaluator, &archive, settings, memberSeed, memberPopulation, generations, memberHooks);
+        }));
+    }
+    SearchResult<Problem> result;
+    result.generationsCompleted = generations;
+    for (size_t m = 0; m < runs.size(); ++m) {
+        SearchResult<Problem> memberResult = runs[m].get();
+        for (const auto& note : memberResult.notes) result.notes.push_back(searchAlgorithmName(members[m]) + ": " + note);
+        // Members stop at the same check, so the slowest one decides how far the portfolio got
+        if (memberResult.generationsCompleted < result.generationsCompleted) {
+            result.generationsCompleted = memberResult.generationsCompleted;
+            result.status = memberResult.status;
+        }
+    }
+
+    result.front = archive.snapshot();
+    result.evaluations = evaluator.evaluationCount();
+    std::string contributions = "Archive contributions:";
+    for (int m = 0; m < memberCount; ++m) {
+        size_t count = std::count_if(result.front.begin(), result.front.end(), [&](const auto& entry) {
+            return entry.source == static_cast<int>(members[m]);
+        });
+        contributions += (m == 0 ? " " : ", ") + searchAlgorithmName(members[m]) + " " + std::to_string(count);
+    }
+    result.notes.insert(result.notes.begin(), contributions);
+    result.notes.insert(result.notes.begin(), "Members: NSGA-II, GDE3 and MOPSO with " + std::to_string(memberPopulation) + " individuals each");
+    return result;
+}
+}
+
+template<MogaProblem Problem>
+SearchResult<Problem> runSearch(const Problem& problem, const OptimizationSettings& settings, unsigned int seed,
+                                int populationSize, int generations, const SearchHooks<Problem>& hooks = {}) {
+    if (settings.algorithm == SearchAlgorithm::Portfolio) {
+        return search_detail::runPortfolio(problem, settings, seed, populationSize, generations, hooks);
+    }
+    ParallelEvaluator<Problem> evaluator(problem, settings.workerThreads, settings.evaluationCacheCapacity);
+    SearchResult<Problem> result = search_detail::runEngine<Problem>(settings.algorithm, evaluator, hooks.archive, settings, seed,
+                                                                     populationSize, generations, hooks);
+    result.evaluations = evaluator.evaluationCount();
+    return result;
+}
+
+#endif // SEARCH_ALGORITHMS_HPP
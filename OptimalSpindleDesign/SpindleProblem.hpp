@@ -0,0 +1,121 @@
+#ifndef SPINDLE_PROBLEM_HPP
+#define SPINDLE_PROBLEM_HPP
+
+#include "Logger.hpp"
+#include "MogaEngine.hpp"
+#include "SpindleSimulation.hpp"
+#include <array>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Spindle arrangement as a MogaEngine problem: minimize vibration, maximize bearing life (negated), minimize temperature rise
+class SpindleProblem {
+public:
+    static constexpr std::size_t objectiveCount = 3;
+    static constexpr std::size_t continuousGenes = 5;   // Power, speed, wheel diameter, preload, alignment tolerance
+    static constexpr std::size_t categoricalGenes = 5;  // Spindle type, bearing type, cooling, lubrication, tool interface
+    static constexpr std::array<int, categoricalGenes> categoryCounts = {3, 2, 2, 3, 3};
+
+    using GenomeType = Genome<continuousGenes, categoricalGenes>;
+    using Objectives = std::array<double, objectiveCount>;
+
+private:
+    struct GeneRange {
+        double min;
+        double max;
+    };
+
+    static constexpr GeneRange continuousRanges[continuousGenes] = {
+        {0.5, 50.0}, {1000.0, 30000.0}, {50.0, 1000.0}, {100.0, 2000.0}, {0.0001, 0.01}
+    };
+    static constexpr const char* spindleTypes[] = {"Belt-Driven", "Direct-Drive", "Motorized"};
+    static constexpr const char* bearingTypes[] = {"Angular Contact", "Hybrid Ceramic"};
+    static constexpr const char* coolingTypes[] = {"Liquid", "Air"};
+    static constexpr const char* lubricationTypes[] = {"Grease", "Oil-Mist", "Oil-Air"};
+    static constexpr const char* toolInterfaces[] = {"Precision Collet", "Hydraulic Chuck", "HSK"};
+    static constexpr const char* const* categoricalOptions[categoricalGenes] = {
+        spindleTypes, bearingTypes, coolingTypes, lubricationTypes, toolInterfaces
+    };
+
+    const SpindleSimulation& simulation;
+    double duration;
+    double loadFactor;
+    Logger* log;   // Failed evaluations are reported here (none = silent)
+
+public:
+    SpindleProblem(const SpindleSimulation& simulation, double duration, double loadFactor, Logger* log = nullptr)
+        : simulation(simulation), duration(duration), loadFactor(loadFactor), log(log) {}
+
+    static SpindleParameters decode(const GenomeType& genome) {
+        auto value = [&](size_t i) {
+            return continuousRanges[i].min + genome.continuous[i] * (continuousRanges[i].max - continuousRanges[i].min);
+        };
+        SpindleParameters params;
+        params.setPowerRating(value(0));
+        params.setMaxSpeed(static_cast<int>(value(1)));
+        params.setWheelDiameter(value(2));
+        params.setBearingPreload(value(3));
+        params.setAlignmentTolerance(value(4));
+        params.setSpindleType(spindleTypes[genome.categorical[0]]);
+        params.setBearingType(bearingTypes[genome.categorical[1]]);
+        params.setCoolingType(coolingTypes[genome.categorical[2]]);
+        params.setLubricationType(lubricationTypes[genome.categorical[3]]);
+        params.setToolInterface(toolInterfaces[genome.categorical[4]]);
+        return params;
+    }
+
+    // Returns false when a categorical value is not one of the known options
+    static bool encode(const SpindleParameters& params, GenomeType& genome) {
+        const double raw[continuousGenes] = {params.getPowerRating(), static_cast<double>(params.getMaxSpeed()), params.getWheelDiameter(),
+                                             params.getBearingPreload(), params.getAlignmentTolerance()};
+        for (size_t i = 0; i < continuousGenes; ++i) {
+            double normalized = (raw[i] - continuousRanges[i].min) / (continuousRanges[i].max - continuousRanges[i].min);
+            genome.continuous[i] = std::max(0.0, std::min(1.0, normalized));
+        }
+        const std::string values[categoricalGenes] = {params.getSpindleType(), params.getBearingType(), params.getCoolingType(),
+                                                      params.getLubricationType(), params.getToolInterface()};
+        for (size_t gene = 0; gene < categoricalGenes; ++gene) {
+            genome.categorical[gene] = -1;
+            for (int option = 0; option < categoryCounts[gene]; ++option) {
+                if (values[gene] == categoricalOptions[gene][option]) genome.categorical[gene] = option;
+            }
+            if (genome.categorical[gene] < 0) return false;
+        }
+        return true;
+    }
+
+    // Reference points arrive as {vibration, bearing life, temperature rise}; bearing life is negated like its objective
+    static Objectives toObjectiveSpace(const std::vector<double>& point) {
+        if (point.size() != objectiveCount) {
+            throw std::invalid_argument("Reference points need vibration, bearing life and temperature rise");
+        }
+        return {point[0], -point[1], point[2]};
+    }
+
+    void evaluate(const GenomeType& genome, Objectives& objectives, std::mt19937& generator) const {
+        SpindleParameters params = decode(genome);
+        try {
+            // Evaluations run on pool threads; each thread reuses one profile buffer
+            thread_local std::vector<double> loadProfile;
+            simulation.generateDynamicLoadProfile(params, duration, loadFactor, generator, loadProfile);
+            if (loadProfile.empty()) {
+                throw std::runtime_error("Empty load profile generated");
+            }
+            double vibration = simulation.estimateVibration(params);
+            double tempRise = simulation.estimateTemperatureRise(params);
+            double bearingLife = simulation.calculateBearingL10Life(params, loadProfile);
+            double wheelWear = simulation.calculateWheelWear(params, loadProfile, duration);
+            double wearVibration = simulation.calculateWearInducedVibration(params, wheelWear);
+            double totalVibration = vibration + wearVibration;
+
+            objectives = {totalVibration, -bearingLife, tempRise};
+        } catch (const std::exception& e) {
+            if (log) SPINDLE_LOG_ERROR(*log, "Error in evaluateObjectives: " << e.what());
+            objectives = {1e10, -1e-10, 1e10}; // Assign worst-case objectives to prevent propagation
+        }
+    }
+};
+
+#endif // SPINDLE_PROBLEM_HPP
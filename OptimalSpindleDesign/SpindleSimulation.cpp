@@ -8,10 +8,110 @@
 #include <limits>
 #include <iostream>
 #include <fstream>
+#include <numeric>
+#include "SpindleProblem.hpp"
+#include "SearchAlgorithms.hpp"
+#include "ParetoMetrics.hpp"
+#include "ReplicateJob.hpp"
+#include "ThreadPool.hpp"
+#include "Logger.hpp"
+#include <chrono>
+
+namespace {
+// Seconds between the samples of a time-based simulation
+constexpr double timeBasedStep = 0.1;
+
+// One writer thread serves every optimization in the process
+Logger& optimizationLog() {
+    static Logger log("optimization_log.txt");
+    return log;
+}
+
+// Reference points, warm-start seeds and time limit shared by single and replicate optimizations
+SearchHooks<SpindleProblem> makeSearchHooks(const OptimizationSettings& settings, const std::vector<SpindleParameters>& warmStart) {
+    SearchHooks<SpindleProblem> hooks;
+    if (settings.timeLimitSeconds > 0.0) {
+        hooks.control.deadline = std::chrono::steady_clock::now() +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(settings.timeLimitSeconds));
+    }
+    for (const auto& point : settings.referencePoints) hooks.referencePoints.push_back(SpindleProblem::toObjectiveSpace(point));
+    for (const auto& params : warmStart) {
+        SpindleProblem::GenomeType genome;
+        if (SpindleProblem::encode(params, genome)) hooks.seedGenomes.push_back(genome);
+    }
+    return hooks;
+}
+
+std::vector<ParetoSolution> toSolutions(const std::vector<ParetoArchive<SpindleProblem>::Entry>& entries) {
+    std::vector<ParetoSolution> solutions;
+    solutions.reserve(entries.size());
+    for (const auto& entry : entries) {
+        solutions.emplace_back(SpindleProblem::decode(entry.genome), entry.objectives[0], -entry.objectives[1], entry.objectives[2]);
+    }
+    return solutions;
+}
 
-std::vector<SpindleSimulation::DataPoint> SpindleSimulation::historicalData;
+OptimizationStatus toOptimizationStatus(SearchStatus status) {
+    if (status == SearchStatus::Cancelled) return OptimizationStatus::Cancelled;
+    if (status == SearchStatus::DeadlineReached) return OptimizationStatus::DeadlineReached;
+    return OptimizationStatus::Completed;
+}
 
-SpindleSimulation::SpindleSimulation() : rng(std::random_device{}()) {}
+// Linearly interpolated quantile, q in [0, 1]
+double quantile(std::vector<double> values, double q) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    double position = q * (values.size() - 1);
+    size_t lower = static_cast<size_t>(position);
+    size_t upper = std::min(lower + 1, values.size() - 1);
+    return values[lower] + (position - lower) * (values[upper] - values[lower]);
+}
+}
+
+std::vector<ParetoSolution> OptimizationHandle::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return liveFront ? liveFront() : finalFront;
+}
+
+void OptimizationHandle::attach(std::function<std::vector<ParetoSolution>()> source) {
+    std::lock_guard<std::mutex> lock(mutex);
+    liveFront = std::move(source);
+    finalFront.clear();
+    telemetryRing.clear();
+}
+
+void OptimizationHandle::detach(const std::vector<ParetoSolution>& front) {
+    std::lock_guard<std::mutex> lock(mutex);
+    liveFront = nullptr;
+    finalFront = front;
+}
+
+void OptimizationHandle::setListener(std::function<void(const SpindleTelemetry&)> callback) {
+    std::lock_guard<std::mutex> lock(mutex);
+    listener = std::move(callback);
+}
+
+void OptimizationHandle::record(const SpindleTelemetry& generation) {
+    telemetryRing.push(generation);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (listener) listener(generation);
+}
+
+SpindleSimulation::SpindleSimulation() : SpindleSimulation(std::random_device{}()) {}
+
+SpindleSimulation::SpindleSimulation(unsigned int seed, const HistoryRetention& retention)
+    : baseSeed(seed), contextCount(0), history(retention, seed) {
+    std::mt19937 generator(seed);
+    // A persistent history that already holds records keeps them instead of a fresh synthetic seed set
+    if (history.size() == 0) generateHistoricalData(generator);
+}
+
+unsigned int SpindleSimulation::nextSeed() const {
+    std::seed_seq sequence{baseSeed, contextCount.fetch_add(1, std::memory_order_relaxed)};
+    unsigned int seed;
+    sequence.generate(&seed, &seed + 1);
+    return seed;
+}
 
 std::string SpindleSimulation::validateParameters(const SpindleParameters& params) const {
     if (params.getPowerRating() < 0.5 || params.getPowerRating() > 50.0)
@@ -28,6 +128,11 @@ std::string SpindleSimulation::validateParameters(const SpindleParameters& param
 }
 
 std::string SpindleSimulation::simulate(const SpindleParameters& params) {
+    EvaluationContext context = makeContext();
+    return simulate(params, context);
+}
+
+std::string SpindleSimulation::simulate(const SpindleParameters& params, EvaluationContext& context) {
     std::string validationResult = validateParameters(params);
     if (validationResult != "Valid")
         return validationResult;
@@ -41,13 +146,14 @@ std::string SpindleSimulation::simulate(const SpindleParameters& params) {
     std::stringstream report;
     report << "=== Systematic Spindle Simulation Results ===\n\n";
     for (const auto& scenario : scenarios) {
-        report << runSimulationStage(params, scenario);
+        report << runSimulationStage(params, scenario, context);
     }
-    report << generateComprehensiveReport(params, scenarios);
+    report << generateComprehensiveReport(params, scenarios, context);
     return report.str();
 }
 
-std::string SpindleSimulation::runSimulationStage(const SpindleParameters& params, const SimulationScenario& scenario) {
+std::string SpindleSimulation::runSimulationStage(const SpindleParameters& params, const SimulationScenario& scenario,
+                                                  EvaluationContext& context) {
     std::stringstream results;
     results << std::fixed << std::setprecision(2);
     results << "=== Scenario: " << scenario.name << " ===\n\n";
@@ -97,7 +203,8 @@ std::string SpindleSimulation::runSimulationStage(const SpindleParameters& param
                 "HSK interface optimal for high-speed operation\n" : "Tool interface suitable for specified parameters\n");
 
     results << "\nDynamic Load Profile:\n";
-    std::vector<double> loadProfile = generateDynamicLoadProfile(adjustedParams, scenario.duration, scenario.loadFactor);
+    std::vector<double>& loadProfile = context.loadProfile;
+    generateDynamicLoadProfile(adjustedParams, scenario.duration, scenario.loadFactor, context.rng, loadProfile);
     results << "Dynamic Load (N) over " << scenario.duration << " seconds:\n";
     for (size_t i = 0; i < loadProfile.size(); ++i) {
         results << "t=" << (i * 0.1) << " s: " << loadProfile[i] << " N\n";
@@ -124,20 +231,20 @@ std::string SpindleSimulation::runSimulationStage(const SpindleParameters& param
     results << (wearVibration <= 0.5 ? "Wear-induced vibration within limits\n" : "Warning: Increased vibration due to wheel imbalance\n");
 
     results << "\nMaintenance Prediction:\n";
-    if (historicalData.empty()) generateHistoricalData();
     double totalVibration = vibrationLevel + wearVibration;
     double avgLoad = std::accumulate(loadProfile.begin(), loadProfile.end(), 0.0) / loadProfile.size();
     int maintenanceNeeded = predictMaintenance(totalVibration, tempRise + 20.0, avgLoad, bearingLifeHours, spindleLifePercentage, wear);
     results << (maintenanceNeeded == 1 ? "Maintenance Needed: Yes (e.g., bearing replacement, wheel dressing)\n" : "Maintenance Needed: No\n");
 
     int label = (totalVibration > 1.0 || bearingLifeHours < 5000 || spindleLifePercentage < 0.5 || wear > initialDiameter * 0.2) ? 1 : 0;
-    historicalData.emplace_back(totalVibration, tempRise + 20.0, avgLoad, bearingLifeHours, spindleLifePercentage, wear, label);
+    history.append(DataPoint(totalVibration, tempRise + 20.0, avgLoad, bearingLifeHours, spindleLifePercentage, wear, label));
 
     results << "\n";
     return results.str();
 }
 
-std::string SpindleSimulation::generateComprehensiveReport(const SpindleParameters& params, const std::vector<SimulationScenario>& scenarios) {
+std::string SpindleSimulation::generateComprehensiveReport(const SpindleParameters& params, const std::vector<SimulationScenario>& scenarios,
+                                                           EvaluationContext& context) const {
     std::stringstream report;
     report << std::fixed << std::setprecision(2);
     report << "=== Comprehensive Analysis ===\n\n";
@@ -158,7 +265,8 @@ std::string SpindleSimulation::generateComprehensiveReport(const SpindleParamete
         adjustedParams.setToolInterface(params.getToolInterface());
         adjustedParams.setAlignmentTolerance(params.getAlignmentTolerance());
 
-        std::vector<double> loadProfile = generateDynamicLoadProfile(adjustedParams, scenario.duration, scenario.loadFactor);
+        std::vector<double>& loadProfile = context.loadProfile;
+        generateDynamicLoadProfile(adjustedParams, scenario.duration, scenario.loadFactor, context.rng, loadProfile);
         double vibration = estimateVibration(adjustedParams);
         double tempRise = estimateTemperatureRise(adjustedParams);
         double bearingLife = calculateBearingL10Life(adjustedParams, loadProfile);
@@ -189,7 +297,8 @@ std::string SpindleSimulation::generateComprehensiveReport(const SpindleParamete
         adjustedParams.setToolInterface(params.getToolInterface());
         adjustedParams.setAlignmentTolerance(params.getAlignmentTolerance());
 
-        std::vector<double> loadProfile = generateDynamicLoadProfile(adjustedParams, scenario.duration, scenario.loadFactor);
+        std::vector<double>& loadProfile = context.loadProfile;
+        generateDynamicLoadProfile(adjustedParams, scenario.duration, scenario.loadFactor, context.rng, loadProfile);
         double vibration = estimateVibration(adjustedParams);
         double tempRise = estimateTemperatureRise(adjustedParams);
         double bearingLife = calculateBearingL10Life(adjustedParams, loadProfile);
@@ -214,31 +323,53 @@ std::string SpindleSimulation::generateComprehensiveReport(const SpindleParamete
 }
 
 std::string SpindleSimulation::simulateTimeBased(const SpindleParameters& params, double duration) {
+    EvaluationContext context = makeContext();
+    return simulateTimeBased(params, duration, context);
+}
+
+std::string SpindleSimulation::simulateTimeBased(const SpindleParameters& params, double duration, EvaluationContext& context) {
     std::string validationResult = validateParameters(params);
     if (validationResult != "Valid")
         return validationResult;
 
     std::stringstream results;
     results << std::fixed << std::setprecision(2);
-    results << "=== Time-Based Spindle Simulation (Duration: " << duration << " s) ===\n\n";
+    int steps = beginTimeBased(params, duration, context, results);
+    double currentTemp = 20.0;
+    advanceTimeBased(params, 0, steps, currentTemp, context, results);
+    finishTimeBased(params, duration, context, results);
+    return results.str();
+}
 
-    double timeStep = 0.1;
-    int steps = static_cast<int>(duration / timeStep);
-    std::vector<double> vibrationHistory, temperatureHistory;
-    std::vector<double> loadProfile = generateDynamicLoadProfile(params, duration, 1.0);
+int SpindleSimulation::beginTimeBased(const SpindleParameters& params, double duration, EvaluationContext& context,
+                                      std::ostream& results) const {
+    results << "=== Time-Based Spindle Simulation (Duration: " << duration << " s) ===\n\n";
+    context.vibrationHistory.clear();
+    context.temperatureHistory.clear();
+    generateDynamicLoadProfile(params, duration, 1.0, context.rng, context.loadProfile);
+    return static_cast<int>(duration / timeBasedStep);
+}
 
-    double currentTemp = 20.0;
-    for (int i = 0; i < steps; ++i) {
-        double load = loadProfile[i];
+void SpindleSimulation::advanceTimeBased(const SpindleParameters& params, int first, int last, double& temperature,
+                                         EvaluationContext& context, std::ostream& results) const {
+    for (int i = first; i < last; ++i) {
+        double load = context.loadProfile[i];
         double vibration = estimateVibration(params, load);
-        currentTemp += estimateTemperatureRise(params, load) * timeStep / 10.0;
-        vibrationHistory.push_back(vibration);
-        temperatureHistory.push_back(currentTemp);
+        temperature += estimateTemperatureRise(params, load) * timeBasedStep / 10.0;
+        context.vibrationHistory.push_back(vibration);
+        context.temperatureHistory.push_back(temperature);
 
         if (i % 10 == 0) {
-            results << "t=" << (i * timeStep) << " s: Vibration=" << vibration << " mm/s, Temperature=" << currentTemp << "°C, Load=" << load << " N\n";
+            results << "t=" << (i * timeBasedStep) << " s: Vibration=" << vibration << " mm/s, Temperature=" << temperature << "°C, Load=" << load << " N\n";
         }
     }
+}
+
+void SpindleSimulation::finishTimeBased(const SpindleParameters& params, double duration, EvaluationContext& context,
+                                        std::ostream& results) {
+    const std::vector<double>& vibrationHistory = context.vibrationHistory;
+    const std::vector<double>& temperatureHistory = context.temperatureHistory;
+    const std::vector<double>& loadProfile = context.loadProfile;
 
     double avgVibration = std::accumulate(vibrationHistory.begin(), vibrationHistory.end(), 0.0) / vibrationHistory.size();
     double maxVibration = *std::max_element(vibrationHistory.begin(), vibrationHistory.end());
@@ -272,16 +403,13 @@ std::string SpindleSimulation::simulateTimeBased(const SpindleParameters& params
     results << (wearVibration <= 0.5 ? "Wear-induced vibration within limits\n" : "Warning: Increased vibration due to wheel imbalance\n");
 
     results << "\nMaintenance Prediction:\n";
-    if (historicalData.empty()) generateHistoricalData();
     double totalVibration = maxVibration + wearVibration;
     double avgLoad = std::accumulate(loadProfile.begin(), loadProfile.end(), 0.0) / loadProfile.size();
     int maintenanceNeeded = predictMaintenance(totalVibration, maxTemp, avgLoad, bearingLifeHours, spindleLifePercentage, wear);
     results << (maintenanceNeeded == 1 ? "Maintenance Needed: Yes (e.g., bearing replacement, wheel dressing)\n" : "Maintenance Needed: No\n");
 
     int label = (totalVibration > 1.0 || bearingLifeHours < 5000 || spindleLifePercentage < 0.5 || wear > initialDiameter * 0.2) ? 1 : 0;
-    historicalData.emplace_back(totalVibration, maxTemp, avgLoad, bearingLifeHours, spindleLifePercentage, wear, label);
-
-    return results.str();
+    history.append(DataPoint(totalVibration, maxTemp, avgLoad, bearingLifeHours, spindleLifePercentage, wear, label));
 }
 
 std::string SpindleSimulation::generateMaintenanceSchedule(const SpindleParameters& params) {
@@ -392,7 +520,20 @@ double SpindleSimulation::estimateLoad(const SpindleParameters& params) const {
 }
 
 std::vector<double> SpindleSimulation::generateDynamicLoadProfile(const SpindleParameters& params, double duration, double loadFactor) const {
+    EvaluationContext context = makeContext();
+    return generateDynamicLoadProfile(params, duration, loadFactor, context.rng);
+}
+
+std::vector<double> SpindleSimulation::generateDynamicLoadProfile(const SpindleParameters& params, double duration, double loadFactor,
+                                                                  std::mt19937& generator) const {
     std::vector<double> loadProfile;
+    generateDynamicLoadProfile(params, duration, loadFactor, generator, loadProfile);
+    return loadProfile;
+}
+
+void SpindleSimulation::generateDynamicLoadProfile(const SpindleParameters& params, double duration, double loadFactor,
+                                                   std::mt19937& generator, std::vector<double>& loadProfile) const {
+    loadProfile.clear();
     double baseLoad = estimateLoad(params) * loadFactor;
     double timeStep = 0.1;
     int steps = static_cast<int>(duration / timeStep);
@@ -402,10 +543,9 @@ std::vector<double> SpindleSimulation::generateDynamicLoadProfile(const SpindleP
         double time = i * timeStep;
         double variation = std::sin(2 * M_PI * time / 2.0) * 0.3;
         double load = baseLoad * (1.0 + variation);
-        if (dist(rng) < 0.1) load *= 1.5;
+        if (dist(generator) < 0.1) load *= 1.5;
         loadProfile.push_back(std::max(0.0, load));
     }
-    return loadProfile;
 }
 
 double SpindleSimulation::calculateBearingL10Life(const SpindleParameters& params, const std::vector<double>& loadProfile) const {
@@ -465,8 +605,9 @@ double SpindleSimulation::calculateWearInducedVibration(const SpindleParameters&
     return std::min(vibrationAmplitude, 2.0);
 }
 
-void SpindleSimulation::generateHistoricalData() {
+void SpindleSimulation::generateHistoricalData(std::mt19937& rng) {
     std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<DataPoint> seedData;
     for (int i = 0; i < 100; ++i) {
         double vibration = 0.2 + dist(rng) * 2.0;
         double temperature = 20.0 + dist(rng) * 30.0;
@@ -475,264 +616,384 @@ void SpindleSimulation::generateHistoricalData() {
         double spindleLife = dist(rng);
         double wheelWear = dist(rng) * 40.0;
         int label = (vibration > 1.0 || bearingLife < 5000 || spindleLife < 0.5 || wheelWear > 40.0 * 0.5) ? 1 : 0;
-        historicalData.emplace_back(vibration, temperature, load, bearingLife, spindleLife, wheelWear, label);
+        seedData.emplace_back(vibration, temperature, load, bearingLife, spindleLife, wheelWear, label);
     }
+    history.appendAll(seedData);
 }
 
-double SpindleSimulation::calculateEuclideanDistance(const DataPoint& p1, const DataPoint& p2) const {
-    double vibDiff = (p1.vibration - p2.vibration) / 2.0;
-    double tempDiff = (p1.temperature - p2.temperature) / 30.0; // Fixed typo: p2opentemperature -> p2.temperature
-    double loadDiff = (p1.load - p2.load) / 1500.0;
-    double bearingLifeDiff = (p1.bearingLife - p2.bearingLife) / 50000.0;
-    double spindleLifeDiff = p1.spindleLife - p2.spindleLife;
-    double wheelWearDiff = (p1.wheelWear - p2.wheelWear) / 40.0;
-
-    return std::sqrt(
-        vibDiff * vibDiff +
-        tempDiff * tempDiff +
-        loadDiff * loadDiff +
-        bearingLifeDiff * bearingLifeDiff +
-        spindleLifeDiff * spindleLifeDiff +
-        wheelWearDiff * wheelWearDiff
-    );
-}
-
-int SpindleSimulation::predictMaintenance(double vibration, double temperature, double load, double bearingLife, double spindleLife, double wheelWear) {
-    if (historicalData.empty()) generateHistoricalData();
-
-    DataPoint query(vibration, temperature, load, bearingLife, spindleLife, wheelWear, 0);
-    std::vector<std::pair<double, int>> distances;
-    for (const auto& data : historicalData) {
-        double distance = calculateEuclideanDistance(query, data);
-        distances.emplace_back(distance, data.label);
+int SpindleSimulation::predictMaintenance(double vibration, double temperature, double load, double bearingLife, double spindleLife,
+                                          double wheelWear) const {
+    if (std::shared_ptr<const MaintenanceClassifier> model = classifier.load()) {
+        return model->predict(DataPoint(vibration, temperature, load, bearingLife, spindleLife, wheelWear, 0));
     }
-
-    std::sort(distances.begin(), distances.end());
-    int k = 3, yesCount = 0;
-    for (int i = 0; i < k && i < distances.size(); ++i) {
-        if (distances[i].second == 1) ++yesCount;
+    const size_t k = 3;
+    MaintenanceIndex::Neighbor neighbors[k];
+    size_t found = history.nearest(DataPoint(vibration, temperature, load, bearingLife, spindleLife, wheelWear, 0), k, neighbors);
+    size_t yesCount = 0;
+    for (size_t i = 0; i < found; ++i) {
+        if (neighbors[i].label == 1) ++yesCount;
     }
 
     return yesCount > k / 2 ? 1 : 0;
 }
 
-// MOGA-related methods
-SpindleParameters SpindleSimulation::generateRandomParameters() {
-    SpindleParameters params;
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-
-    // Continuous parameters
-    params.setPowerRating(0.5 + dist(rng) * (50.0 - 0.5));
-    params.setMaxSpeed(static_cast<int>(1000 + dist(rng) * (30000 - 1000)));
-    params.setWheelDiameter(50.0 + dist(rng) * (1000.0 - 50.0));
-    params.setBearingPreload(100.0 + dist(rng) * (2000.0 - 100.0));
-    params.setAlignmentTolerance(0.0001 + dist(rng) * (0.01 - 0.0001));
-
-    // Categorical parameters
-    std::vector<std::string> spindleTypes = {"Belt-Driven", "Direct-Drive", "Motorized"};
-    params.setSpindleType(spindleTypes[static_cast<int>(dist(rng) * spindleTypes.size())]);
-
-    std::vector<std::string> bearingTypes = {"Angular Contact", "Hybrid Ceramic"};
-    params.setBearingType(bearingTypes[static_cast<int>(dist(rng) * bearingTypes.size())]);
-
-    std::vector<std::string> coolingTypes = {"Liquid", "Air"};
-    params.setCoolingType(coolingTypes[static_cast<int>(dist(rng) * coolingTypes.size())]);
-
-    std::vector<std::string> lubricationTypes = {"Grease", "Oil-Mist", "Oil-Air"};
-    params.setLubricationType(lubricationTypes[static_cast<int>(dist(rng) * lubricationTypes.size())]);
+std::vector<std::string> SpindleSimulation::simulateBatch(const std::vector<SpindleParameters>& configurations) {
+    ThreadPool& executor = ThreadPool::shared();
+    std::vector<std::future<std::string>> pending;
+    pending.reserve(configurations.size());
+    for (const auto& params : configurations) {
+        // Seeds are drawn in submission order so a seeded simulation gives the same reports whatever the scheduling
+        unsigned int seed = nextSeed();
+        pending.push_back(executor.submit([this, &params, seed]() {
+            EvaluationContext context(seed);
+            return simulate(params, context);
+        }));
+    }
+    std::vector<std::string> reports;
+    reports.reserve(pending.size());
+    for (auto& report : pending) reports.push_back(executor.wait(report));
+    return reports;
+}
 
-    std::vector<std::string> toolInterfaces = {"Precision Collet", "Hydraulic Chuck", "HSK"};
-    params.setToolInterface(toolInterfaces[static_cast<int>(dist(rng) * toolInterfaces.size())]);
+std::vector<SweepPoint> SpindleSimulation::sweepParameter(const SpindleParameters& base, SweepVariable variable, double from, double to,
+                                                          int steps, double duration, double loadFactor) const {
+    if (steps < 1 || duration <= 0.0) {
+        throw std::invalid_argument("A sweep needs at least one step and a positive duration");
+    }
+    std::vector<SweepPoint> points(steps);
+    for (int i = 0; i < steps; ++i) {
+        double value = steps == 1 ? from : from + (to - from) * i / (steps - 1);
+        SpindleParameters params = base;
+        switch (variable) {
+            case SweepVariable::PowerRating: params.setPowerRating(value); break;
+            case SweepVariable::MaxSpeed: params.setMaxSpeed(static_cast<int>(value)); break;
+            case SweepVariable::WheelDiameter: params.setWheelDiameter(value); break;
+            case SweepVariable::BearingPreload: params.setBearingPreload(value); break;
+            case SweepVariable::AlignmentTolerance: params.setAlignmentTolerance(value); break;
+        }
+        if (validateParameters(params) != "Valid") {
+            throw std::invalid_argument("Sweep value " + std::to_string(value) + " is outside the valid parameter range");
+        }
+        points[i].params = params;
+        points[i].value = value;
+    }
 
-    return params;
+    ThreadPool& executor = ThreadPool::shared();
+    std::vector<std::future<void>> pending;
+    pending.reserve(points.size());
+    for (auto& point : points) {
+        unsigned int seed = nextSeed();
+        pending.push_back(executor.submit([this, &point, seed, duration, loadFactor]() {
+            EvaluationContext context(seed);
+            const SpindleParameters& params = point.params;
+            generateDynamicLoadProfile(params, duration, loadFactor, context.rng, context.loadProfile);
+            const std::vector<double>& loadProfile = context.loadProfile;
+            double avgLoad = std::accumulate(loadProfile.begin(), loadProfile.end(), 0.0) / loadProfile.size();
+            point.wheelWear = calculateWheelWear(params, loadProfile, duration);
+            point.vibration = estimateVibration(params) + calculateWearInducedVibration(params, point.wheelWear);
+            point.temperatureRise = estimateTemperatureRise(params);
+            point.bearingLife = calculateBearingL10Life(params, loadProfile);
+            point.spindleLife = calculateSpindleFatigueLife(params, loadProfile);
+            point.maintenanceNeeded = predictMaintenance(point.vibration, point.temperatureRise + 20.0, avgLoad, point.bearingLife,
+                                                         point.spindleLife, point.wheelWear);
+        }));
+    }
+    for (auto& evaluation : pending) executor.wait(evaluation);
+    return points;
 }
 
-void SpindleSimulation::evaluateObjectives(Individual& ind, double duration, double loadFactor) {
-    try {
-        std::vector<double> loadProfile = generateDynamicLoadProfile(ind.params, duration, loadFactor);
-        if (loadProfile.empty()) {
-            throw std::runtime_error("Empty load profile generated");
+std::vector<int> SpindleSimulation::predictMaintenanceBatch(std::span<const MaintenanceRecord> queries,
+                                                           std::vector<float>* neighborDistances) const {
+    // Blocks are large enough for the index to reuse cached leaves between neighbouring queries and small enough to
+    // spread a fleet-sized batch over every worker
+    const size_t k = 3;
+    const size_t blockSize = 1024;
+    ThreadPool& executor = ThreadPool::shared();
+    std::vector<std::future<void>> pending;
+    if (std::shared_ptr<const MaintenanceClassifier> model = classifier.load()) {
+        if (neighborDistances) neighborDistances->clear();
+        std::vector<int> labels(queries.size(), 0);
+        for (size_t first = 0; first < queries.size(); first += blockSize) {
+            size_t last = std::min(queries.size(), first + blockSize);
+            pending.push_back(executor.submit([&model, queries, &labels, first, last]() {
+                model->predictBatch(queries.subspan(first, last - first), labels.data() + first);
+            }));
         }
-        double vibration = estimateVibration(ind.params);
-        double tempRise = estimateTemperatureRise(ind.params);
-        double bearingLife = calculateBearingL10Life(ind.params, loadProfile);
-        double wheelWear = calculateWheelWear(ind.params, loadProfile, duration);
-        double wearVibration = calculateWearInducedVibration(ind.params, wheelWear);
-        double totalVibration = vibration + wearVibration;
-
-        ind.objectives = {totalVibration, -bearingLife, tempRise}; // Minimize vibration, maximize bearing life (negated), minimize temperature
-    } catch (const std::exception& e) {
-        std::cerr << "Error in evaluateObjectives: " << e.what() << std::endl;
-        ind.objectives = {1e10, -1e-10, 1e10}; // Assign worst-case objectives to prevent propagation
+        for (auto& block : pending) executor.wait(block);
+        return labels;
+    }
+    // Every block queries the one version loaded here, so the whole batch sees the same records however many appends
+    // land meanwhile and the shared pointer is loaded once rather than once per block. A persistent history has no
+    // versions and snapshots inside each of its own queries.
+    std::shared_ptr<const MaintenanceHistory::Version> version = history.current();
+    std::vector<MaintenanceIndex::Neighbor> neighbors(queries.size() * k);
+    std::vector<size_t> found(queries.size(), 0);
+    for (size_t first = 0; first < queries.size(); first += blockSize) {
+        size_t last = std::min(queries.size(), first + blockSize);
+        pending.push_back(executor.submit([this, &version, queries, &neighbors, &found, first, last]() {
+            std::span<const MaintenanceRecord> block = queries.subspan(first, last - first);
+            if (version) version->nearestBatch(block, k, neighbors.data() + first * k, found.data() + first);
+            else history.nearestBatch(block, k, neighbors.data() + first * k, found.data() + first);
+        }));
     }
+    for (auto& block : pending) executor.wait(block);
+
+    std::vector<int> labels(queries.size(), 0);
+    if (neighborDistances) neighborDistances->assign(queries.size() * k, std::numeric_limits<float>::infinity());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        size_t yesCount = 0;
+        for (size_t j = 0; j < found[i]; ++j) {
+            const MaintenanceIndex::Neighbor& neighbor = neighbors[i * k + j];
+            if (neighbor.label == 1) ++yesCount;
+            if (neighborDistances) (*neighborDistances)[i * k + j] = std::sqrt(neighbor.distance);
+        }
+        labels[i] = yesCount > k / 2 ? 1 : 0;
+    }
+    return labels;
 }
 
-bool SpindleSimulation::dominates(const Individual& a, const Individual& b) const {
-    bool betterInAtLeastOne = false;
-    for (size_t i = 0; i < a.objectives.size(); ++i) {
-        if (a.objectives[i] > b.objectives[i]) return false; // a is worse in at least one objective
-        if (a.objectives[i] < b.objectives[i]) betterInAtLeastOne = true; // a is better in at least one
+std::vector<int> SpindleSimulation::predictMaintenanceTimeSeries(const SpindleParameters& params, double duration,
+                                                                 std::vector<float>* neighborDistances) {
+    std::string validationResult = validateParameters(params);
+    if (validationResult != "Valid") {
+        throw std::invalid_argument(validationResult);
+    }
+    // Anything shorter leaves an empty load profile, whose lives come out as 0/0 and reach the model as NaN features
+    if (!(duration >= timeBasedStep)) {
+        throw std::invalid_argument("A maintenance time series needs a duration of at least one 0.1 s step");
+    }
+    EvaluationContext context = makeContext();
+    std::vector<double>& loadProfile = context.loadProfile;
+    generateDynamicLoadProfile(params, duration, 1.0, context.rng, loadProfile);
+    int steps = static_cast<int>(duration / timeBasedStep);
+    double bearingLife = calculateBearingL10Life(params, loadProfile);
+    double spindleLife = calculateSpindleFatigueLife(params, loadProfile);
+    // Wear grows with the load integrated over time, up to the 20% limit calculateWheelWear applies
+    double wearPerLoadSecond = calculateWheelWear(params, std::vector<double>{1.0}, 1.0);
+
+    std::vector<MaintenanceRecord> queries;
+    queries.reserve(steps);
+    double temperature = 20.0;
+    double loadIntegral = 0.0;
+    for (int i = 0; i < steps; ++i) {
+        double load = loadProfile[i];
+        temperature += estimateTemperatureRise(params, load) * timeBasedStep / 10.0;
+        loadIntegral += load * timeBasedStep;
+        double wear = std::min(wearPerLoadSecond * loadIntegral, params.getWheelDiameter() * 0.2);
+        double vibration = estimateVibration(params, load) + calculateWearInducedVibration(params, wear);
+        queries.emplace_back(vibration, temperature, load, bearingLife, spindleLife, wear, 0);
     }
-    return betterInAtLeastOne;
+    return predictMaintenanceBatch(queries, neighborDistances);
 }
 
-void SpindleSimulation::nonDominatedSorting(std::vector<Individual>& population) {
-    std::ofstream log("optimization_log.txt", std::ios::app);
-    log << "Starting nonDominatedSorting with population size: " << population.size() << std::endl;
-    std::cout << "Starting nonDominatedSorting with population size: " << population.size() << std::endl;
-
-    std::vector<std::vector<size_t>> fronts;
-    std::vector<int> dominationCount(population.size(), 0);
-    std::vector<std::vector<size_t>> dominatedBy(population.size());
+HistoryImportReport SpindleSimulation::importMaintenanceHistory(const std::string& path, const HistoryImportOptions& options) {
+    return importMaintenanceCsv(path, history, options);
+}
 
-    // Compute domination counts and dominated sets
-    for (size_t i = 0; i < population.size(); ++i) {
-        for (size_t j = 0; j < population.size(); ++j) {
-            if (i == j) continue;
-            if (dominates(population[i], population[j])) {
-                dominatedBy[i].push_back(j);
-            } else if (dominates(population[j], population[i])) {
-                dominationCount[i]++;
-            }
-        }
-        if (dominationCount[i] == 0) {
-            population[i].rank = 1;
-            if (fronts.empty()) fronts.push_back({});
-            fronts[0].push_back(i);
-        }
+std::shared_ptr<const MaintenanceClassifier> SpindleSimulation::trainMaintenanceModel(const ClassifierSettings& settings) {
+    if (settings.model == MaintenanceModel::Neighbors) {
+        classifier.store(nullptr);
+        return nullptr;
     }
+    std::vector<DataPoint> stored = history.snapshot();
+    auto model = std::make_shared<const MaintenanceClassifier>(trainMaintenanceClassifier(stored, settings));
+    classifier.store(model);
+    return model;
+}
 
-    // Build subsequent fronts
-    size_t frontIdx = 0;
-    while (frontIdx < fronts.size() && !fronts[frontIdx].empty()) {
-        std::vector<size_t> nextFront;
-        for (size_t i : fronts[frontIdx]) {
-            for (size_t j : dominatedBy[i]) {
-                dominationCount[j]--;
-                if (dominationCount[j] == 0) {
-                    population[j].rank = frontIdx + 2;
-                    nextFront.push_back(j);
-                }
-            }
-        }
-        if (!nextFront.empty()) fronts.push_back(nextFront);
-        frontIdx++;
-    }
+MaintenanceModel SpindleSimulation::maintenanceModel() const {
+    std::shared_ptr<const MaintenanceClassifier> model = classifier.load();
+    return model ? model->model() : MaintenanceModel::Neighbors;
+}
 
-    // Compute crowding distance for each front
-    for (size_t f = 0; f < fronts.size(); ++f) {
-        const auto& front = fronts[f];
-        log << "Processing front " << f + 1 << " with " << front.size() << " individuals" << std::endl;
-        if (front.size() <= 2) {
-            for (size_t i : front) population[i].crowdingDistance = std::numeric_limits<double>::infinity();
-            continue;
-        }
-        std::vector<size_t> sortedFront = front;
-        for (size_t objIdx = 0; objIdx < population[front[0]].objectives.size(); ++objIdx) {
-            std::sort(sortedFront.begin(), sortedFront.end(), [&](size_t a, size_t b) {
-                return population[a].objectives[objIdx] < population[b].objectives[objIdx];
-            });
-            population[sortedFront.front()].crowdingDistance = std::numeric_limits<double>::infinity();
-            population[sortedFront.back()].crowdingDistance = std::numeric_limits<double>::infinity();
-            double objRange = population[sortedFront.back()].objectives[objIdx] - population[sortedFront.front()].objectives[objIdx];
-            if (std::abs(objRange) < 1e-10) continue; // Skip if range is effectively zero
-            for (size_t i = 1; i < sortedFront.size() - 1; ++i) {
-                if (i + 1 < sortedFront.size() && i >= 1) {
-                    population[sortedFront[i]].crowdingDistance +=
-                        (population[sortedFront[i + 1]].objectives[objIdx] - population[sortedFront[i - 1]].objectives[objIdx]) / objRange;
-                }
-            }
+NeighborRecall SpindleSimulation::measureMaintenanceRecall(size_t sampleCount) const {
+    std::vector<DataPoint> stored = history.snapshot();
+    std::vector<DataPoint> queries;
+    if (!stored.empty()) {
+        std::mt19937 generator(nextSeed());
+        std::uniform_int_distribution<size_t> pick(0, stored.size() - 1);
+        queries.reserve(sampleCount);
+        for (size_t i = 0; i < sampleCount; ++i) {
+            const DataPoint& a = stored[pick(generator)];
+            const DataPoint& b = stored[pick(generator)];
+            queries.emplace_back((a.vibration + b.vibration) / 2, (a.temperature + b.temperature) / 2, (a.load + b.load) / 2,
+                                 (a.bearingLife + b.bearingLife) / 2, (a.spindleLife + b.spindleLife) / 2, (a.wheelWear + b.wheelWear) / 2, 0);
         }
     }
-    log << "Completed nonDominatedSorting, fronts created: " << fronts.size() << std::endl;
-    std::cout << "Completed nonDominatedSorting, fronts created: " << fronts.size() << std::endl;
-    log.close();
+    return history.measureRecall(queries, 3);
 }
 
-SpindleSimulation::Individual SpindleSimulation::crossover(const Individual& parent1, const Individual& parent2) {
-    Individual offspring;
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-    double alpha = 0.5; // BLX-α parameter
-
-    // Continuous parameters
-    auto blend = [&](double p1, double p2, double min, double max) {
-        double d = std::abs(p1 - p2);
-        double lower = std::min(p1, p2) - alpha * d;
-        double upper = std::max(p1, p2) + alpha * d;
-        return std::max(min, std::min(max, lower + dist(rng) * (upper - lower)));
-    };
-
-    offspring.params.setPowerRating(blend(parent1.params.getPowerRating(), parent2.params.getPowerRating(), 0.5, 50.0));
-    offspring.params.setMaxSpeed(static_cast<int>(blend(parent1.params.getMaxSpeed(), parent2.params.getMaxSpeed(), 1000, 30000)));
-    offspring.params.setWheelDiameter(blend(parent1.params.getWheelDiameter(), parent2.params.getWheelDiameter(), 50.0, 1000.0));
-    offspring.params.setBearingPreload(blend(parent1.params.getBearingPreload(), parent2.params.getBearingPreload(), 100.0, 2000.0));
-    offspring.params.setAlignmentTolerance(blend(parent1.params.getAlignmentTolerance(), parent2.params.getAlignmentTolerance(), 0.0001, 0.01));
+Task<std::string> SpindleSimulation::simulateAsync(SpindleParameters params) {
+    co_await resumeOn(ThreadPool::shared());
+    co_return simulate(params);
+}
 
-    // Categorical parameters (uniform crossover)
-    offspring.params.setSpindleType(dist(rng) < 0.5 ? parent1.params.getSpindleType() : parent2.params.getSpindleType());
-    offspring.params.setBearingType(dist(rng) < 0.5 ? parent1.params.getBearingType() : parent2.params.getBearingType());
-    offspring.params.setCoolingType(dist(rng) < 0.5 ? parent1.params.getCoolingType() : parent2.params.getCoolingType());
-    offspring.params.setLubricationType(dist(rng) < 0.5 ? parent1.params.getLubricationType() : parent2.params.getLubricationType());
-    offspring.params.setToolInterface(dist(rng) < 0.5 ? parent1.params.getToolInterface() : parent2.params.getToolInterface());
+Task<std::string> SpindleSimulation::simulateTimeBasedAsync(SpindleParameters params, double duration) {
+    co_await resumeOn(ThreadPool::shared());
+    co_return simulateTimeBased(params, duration);
+}
 
-    return offspring;
+Task<OptimizationResult> SpindleSimulation::optimizeSpindleArrangementAsync(double duration, double loadFactor, int populationSize,
+                                                                            int generations, OptimizationSettings settings,
+                                                                            OptimizationHandle& handle) {
+    co_await resumeOn(ThreadPool::shared());
+    co_return optimizeSpindleArrangement(duration, loadFactor, populationSize, generations, settings, handle);
 }
 
-void SpindleSimulation::mutate(Individual& ind) {
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-    double mutationProb = 0.1;
-
-    // Continuous parameters (polynomial mutation)
-    auto mutateContinuous = [&](double value, double min, double max, double eta = 20.0) {
-        if (dist(rng) >= mutationProb) return value;
-        double delta1 = (value - min) / (max - min);
-        double delta2 = (max - value) / (max - min);
-        double rand = dist(rng);
-        double deltaq = (rand <= 0.5) ?
-            std::pow(2.0 * rand, 1.0 / (eta + 1.0)) - 1.0 :
-            1.0 - std::pow(2.0 * (1.0 - rand), 1.0 / (eta + 1.0));
-        double delta = (deltaq < 0 ? delta1 : delta2) * deltaq;
-        return std::max(min, std::min(max, value + delta * (max - min)));
-    };
+AsyncGenerator<TimeBasedProgress> SpindleSimulation::simulateTimeBasedStream(SpindleParameters params, double duration, int interval) {
+    co_await resumeOn(ThreadPool::shared());
+    TimeBasedProgress progress;
+    std::string validationResult = validateParameters(params);
+    if (validationResult != "Valid") {
+        progress.report = validationResult;
+        co_yield progress;
+        co_return;
+    }
 
-    ind.params.setPowerRating(mutateContinuous(ind.params.getPowerRating(), 0.5, 50.0));
-    ind.params.setMaxSpeed(static_cast<int>(mutateContinuous(ind.params.getMaxSpeed(), 1000, 30000)));
-    ind.params.setWheelDiameter(mutateContinuous(ind.params.getWheelDiameter(), 50.0, 1000.0));
-    ind.params.setBearingPreload(mutateContinuous(ind.params.getBearingPreload(), 100.0, 2000.0));
-    ind.params.setAlignmentTolerance(mutateContinuous(ind.params.getAlignmentTolerance(), 0.0001, 0.01));
+    EvaluationContext context = makeContext();
+    std::stringstream results;
+    results << std::fixed << std::setprecision(2);
+    progress.totalSteps = beginTimeBased(params, duration, context, results);
+    interval = std::max(1, interval);
+    double currentTemp = 20.0;
+    while (progress.step < progress.totalSteps) {
+        int last = std::min(progress.totalSteps, progress.step + interval);
+        advanceTimeBased(params, progress.step, last, currentTemp, context, results);
+        progress.step = last;
+        progress.time = last * timeBasedStep;
+        progress.vibration = context.vibrationHistory.back();
+        progress.temperature = currentTemp;
+        progress.load = context.loadProfile[last - 1];
+        co_yield progress;
+        // The consumer resumes the stream on its own thread; the next interval goes back to the executor
+        co_await resumeOn(ThreadPool::shared());
+    }
+    finishTimeBased(params, duration, context, results);
+    progress.report = results.str();
+    co_yield progress;
+}
+
+AsyncGenerator<OptimizationProgress> SpindleSimulation::optimizeSpindleArrangementStream(double duration, double loadFactor,
+                                                                                        int populationSize, int generations,
+                                                                                        OptimizationSettings settings,
+                                                                                        std::shared_ptr<OptimizationHandle> handle) {
+    if (!handle) handle = std::make_shared<OptimizationHandle>();
+    // Telemetry arrives on the optimizer's threads; the queue hands it to this coroutine without blocking them
+    auto queue = std::make_shared<AsyncQueue<OptimizationProgress>>();
+    handle->setListener([queue](const SpindleTelemetry& record) {
+        OptimizationProgress progress;
+        progress.generation = record;
+        queue->push(std::move(progress));
+    });
+    auto finished = std::make_shared<std::atomic<bool>>(false);
+    ThreadPool::shared().post([this, queue, handle, finished, duration, loadFactor, populationSize, generations, settings]() {
+        OptimizationProgress outcome;
+        outcome.result = optimizeSpindleArrangement(duration, loadFactor, populationSize, generations, settings, *handle);
+        handle->setListener(nullptr);
+        finished->store(true);
+        queue->push(std::move(outcome));
+        queue->close();
+    });
+
+    // Destroyed with the frame, so a consumer that drops the stream before the result cancels the run. It does not
+    // wait: the consumer may be running inside one of the run's own waits on the executor.
+    struct CancelOnDrop {
+        std::shared_ptr<OptimizationHandle> handle;
+        std::shared_ptr<std::atomic<bool>> finished;
+        ~CancelOnDrop() {
+            if (!finished->load()) handle->cancel();
+        }
+    } cancelOnDrop{handle, finished};
 
-    // Categorical parameters
-    if (dist(rng) < mutationProb) {
-        std::vector<std::string> spindleTypes = {"Belt-Driven", "Direct-Drive", "Motorized"};
-        ind.params.setSpindleType(spindleTypes[static_cast<int>(dist(rng) * spindleTypes.size())]);
+    while (std::optional<OptimizationProgress> progress = co_await queue->pop()) {
+        co_yield std::move(*progress);
     }
-    if (dist(rng) < mutationProb) {
-        std::vector<std::string> bearingTypes = {"Angular Contact", "Hybrid Ceramic"};
-        ind.params.setBearingType(bearingTypes[static_cast<int>(dist(rng) * bearingTypes.size())]);
+}
+
+// MOGA-related methods
+std::vector<SpindleParameters> SpindleSimulation::loadFrontFile(const std::string& path) const {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open front file: " + path);
     }
-    if (dist(rng) < mutationProb) {
-        std::vector<std::string> coolingTypes = {"Liquid", "Air"};
-        ind.params.setCoolingType(coolingTypes[static_cast<int>(dist(rng) * coolingTypes.size())]);
+
+    std::vector<SpindleParameters> front;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line.rfind("powerRating", 0) == 0) continue;
+
+        std::vector<std::string> fields;
+        std::stringstream row(line);
+        std::string field;
+        while (std::getline(row, field, ',')) fields.push_back(field);
+        if (fields.size() < SpindleProblem::continuousGenes + SpindleProblem::categoricalGenes) continue;
+
+        try {
+            SpindleParameters params;
+            params.setPowerRating(std::stod(fields[0]));
+            params.setMaxSpeed(std::stoi(fields[1]));
+            params.setWheelDiameter(std::stod(fields[2]));
+            params.setBearingPreload(std::stod(fields[3]));
+            params.setAlignmentTolerance(std::stod(fields[4]));
+            params.setSpindleType(fields[5]);
+            params.setBearingType(fields[6]);
+            params.setCoolingType(fields[7]);
+            params.setLubricationType(fields[8]);
+            params.setToolInterface(fields[9]);
+            SpindleProblem::GenomeType genome;
+            if (SpindleProblem::encode(params, genome) && validateParameters(params) == "Valid") front.push_back(params);
+        } catch (const std::exception&) {
+            continue; // Skip malformed rows rather than abandoning the warm start
+        }
     }
-    if (dist(rng) < mutationProb) {
-        std::vector<std::string> lubricationTypes = {"Grease", "Oil-Mist", "Oil-Air"};
-        ind.params.setLubricationType(lubricationTypes[static_cast<int>(dist(rng) * lubricationTypes.size())]);
+    return front;
+}
+
+void SpindleSimulation::writeFrontFile(const std::string& path, const std::vector<ParetoSolution>& front) const {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot write front file: " + path);
     }
-    if (dist(rng) < mutationProb) {
-        std::vector<std::string> toolInterfaces = {"Precision Collet", "Hydraulic Chuck", "HSK"};
-        ind.params.setToolInterface(toolInterfaces[static_cast<int>(dist(rng) * toolInterfaces.size())]);
+    file << "powerRating,maxSpeed,wheelDiameter,bearingPreload,alignmentTolerance,spindleType,bearingType,"
+         << "coolingType,lubricationType,toolInterface,vibration,bearingLife,temperatureRise\n";
+    file << std::setprecision(10);
+    for (const auto& solution : front) {
+        const SpindleParameters& params = solution.params;
+        file << params.getPowerRating() << ',' << params.getMaxSpeed() << ',' << params.getWheelDiameter() << ','
+             << params.getBearingPreload() << ',' << params.getAlignmentTolerance() << ','
+             << params.getSpindleType() << ',' << params.getBearingType() << ',' << params.getCoolingType() << ','
+             << params.getLubricationType() << ',' << params.getToolInterface() << ','
+             << solution.vibration << ',' << solution.bearingLife << ',' << solution.temperatureRise << '\n';
     }
 }
 
 std::string SpindleSimulation::optimizeSpindleArrangement(double duration, double loadFactor, int populationSize, int generations) {
-    std::ofstream log("optimization_log.txt", std::ios::app);
-    log << "Starting optimizeSpindleArrangement with duration: " << duration
+    return optimizeSpindleArrangement(duration, loadFactor, populationSize, generations, OptimizationSettings());
+}
+
+std::string SpindleSimulation::optimizeSpindleArrangement(double duration, double loadFactor, int populationSize, int generations,
+                                                          const OptimizationSettings& settings) {
+    OptimizationHandle handle;
+    OptimizationResult result = optimizeSpindleArrangement(duration, loadFactor, populationSize, generations, settings, handle);
+    if (result.status == OptimizationStatus::Failed) {
+        return "Error: Optimization failed - " + result.error + "\n";
+    }
+    return result.report;
+}
+
+OptimizationResult SpindleSimulation::optimizeSpindleArrangement(double duration, double loadFactor, int populationSize, int generations,
+                                                                 const OptimizationSettings& settings, OptimizationHandle& handle) {
+    auto start = std::chrono::steady_clock::now();
+    Logger& log = optimizationLog();
+    SPINDLE_LOG_INFO(log, "Starting optimizeSpindleArrangement with duration: " << duration
         << ", loadFactor: " << loadFactor << ", populationSize: " << populationSize
-        << ", generations: " << generations << std::endl;
-    std::cout << "Starting optimizeSpindleArrangement with duration: " << duration
-              << ", loadFactor: " << loadFactor << ", populationSize: " << populationSize
-              << ", generations: " << generations << std::endl;
+        << ", generations: " << generations);
 
+    // Every engine feeds the archive, so snapshots and failures still see the best front found so far
+    OptimizationResult outcome;
+    ParetoArchive<SpindleProblem> archive(settings.archiveCapacity);
+    handle.attach([&archive]() { return toSolutions(archive.snapshot()); });
     try {
         // Validate inputs
         if (duration <= 0.0) {
@@ -745,196 +1006,77 @@ std::string SpindleSimulation::optimizeSpindleArrangement(double duration, doubl
             throw std::invalid_argument("Population size must be at least 10 and generations at least 1");
         }
 
-        std::vector<Individual> population(populationSize);
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
-
-        // Initialize population
-        log << "Initializing population..." << std::endl;
-        std::cout << "Initializing population..." << std::endl;
-        for (size_t i = 0; i < population.size(); ++i) {
-            log << "Generating parameters for individual " << i + 1 << "/" << populationSize << std::endl;
-            population[i].params = generateRandomParameters();
-            log << "Evaluating objectives for individual " << i + 1 << "/" << populationSize << std::endl;
-            evaluateObjectives(population[i], duration, loadFactor);
+        SpindleProblem problem(*this, duration, loadFactor, &log);
+        std::vector<SpindleParameters> warmStart;
+        if (!settings.warmStartPath.empty()) {
+            warmStart = loadFrontFile(settings.warmStartPath);
+            SPINDLE_LOG_INFO(log, "Warm-starting from " << warmStart.size() << " configurations in " << settings.warmStartPath);
         }
-        log << "Performing initial non-dominated sorting..." << std::endl;
-        nonDominatedSorting(population);
-
-        // Main loop
-        for (int gen = 0; gen < generations; ++gen) {
-            log << "Generation " << gen + 1 << "/" << generations << std::endl;
-            std::cout << "Generation " << gen + 1 << "/" << generations << std::endl;
-            std::vector<Individual> offspring;
-
-            // Tournament selection and offspring creation
-            log << "Performing tournament selection and creating offspring..." << std::endl;
-            std::cout << "Performing tournament selection and creating offspring..." << std::endl;
-            size_t offspringCount = 0;
-            while (offspring.size() < populationSize) {
-                size_t idx1 = static_cast<size_t>(dist(rng) * populationSize);
-                size_t idx2 = static_cast<size_t>(dist(rng) * populationSize);
-                if (idx1 >= population.size() || idx2 >= population.size()) {
-                    log << "Error: Invalid tournament indices idx1=" << idx1 << ", idx2=" << idx2 << std::endl;
-                    throw std::runtime_error("Invalid tournament indices");
-                }
-                Individual parent1 = population[idx1];
-                Individual parent2 = population[idx2];
-                log << "Selected parents idx1=" << idx1 << " (rank=" << parent1.rank << "), idx2=" << idx2 << " (rank=" << parent2.rank << ")" << std::endl;
-                Individual offspringInd;
-                if (parent1.rank < parent2.rank || (parent1.rank == parent2.rank && parent1.crowdingDistance > parent2.crowdingDistance)) {
-                    offspringInd = crossover(parent1, parent2);
-                } else {
-                    offspringInd = crossover(parent2, parent1);
-                }
-                log << "Performing mutation on offspring " << offspringCount + 1 << std::endl;
-                mutate(offspringInd);
-                log << "Evaluating objectives for offspring " << offspringCount + 1 << std::endl;
-                evaluateObjectives(offspringInd, duration, loadFactor);
-                offspring.push_back(offspringInd);
-                offspringCount++;
-            }
-
-            // Combine parent and offspring populations
-            log << "Combining populations..." << std::endl;
-            std::cout << "Combining populations..." << std::endl;
-            std::vector<Individual> combined = population;
-            combined.insert(combined.end(), offspring.begin(), offspring.end());
-            if (combined.empty()) {
-                log << "Error: Combined population is empty" << std::endl;
-                throw std::runtime_error("Combined population is empty");
-            }
-            log << "Combined population size: " << combined.size() << std::endl;
-            std::cout << "Combined population size: " << combined.size() << std::endl;
-
-            // Recompute fronts for combined population
-            log << "Recomputing fronts..." << std::endl;
-            std::cout << "Recomputing fronts..." << std::endl;
-            std::vector<std::vector<size_t>> fronts;
-            std::vector<int> dominationCount(combined.size(), 0);
-            std::vector<std::vector<size_t>> dominatedBy(combined.size());
-
-            for (size_t i = 0; i < combined.size(); ++i) {
-                for (size_t j = 0; j < combined.size(); ++j) {
-                    if (i == j) continue;
-                    if (dominates(combined[i], combined[j])) {
-                        dominatedBy[i].push_back(j);
-                    } else if (dominates(combined[j], combined[i])) {
-                        dominationCount[i]++;
-                    }
-                }
-                if (dominationCount[i] == 0) {
-                    combined[i].rank = 1;
-                    if (fronts.empty()) fronts.push_back({});
-                    fronts[0].push_back(i);
-                }
-            }
-
-            size_t frontIdx = 0;
-            while (frontIdx < fronts.size() && !fronts[frontIdx].empty()) {
-                std::vector<size_t> nextFront;
-                for (size_t i : fronts[frontIdx]) {
-                    for (size_t j : dominatedBy[i]) {
-                        dominationCount[j]--;
-                        if (dominationCount[j] == 0) {
-                            combined[j].rank = frontIdx + 2;
-                            nextFront.push_back(j);
-                        }
-                    }
-                }
-                if (!nextFront.empty()) fronts.push_back(nextFront);
-                frontIdx++;
-            }
-            log << "Fronts recomputed, total fronts: " << fronts.size() << std::endl;
-            std::cout << "Fronts recomputed, total fronts: " << fronts.size() << std::endl;
-
-            // Compute crowding distance
-            log << "Computing crowding distances..." << std::endl;
-            std::cout << "Computing crowding distances..." << std::endl;
-            for (size_t f = 0; f < fronts.size(); ++f) {
-                const auto& front = fronts[f];
-                log << "Processing front " << f + 1 << " with " << front.size() << " individuals" << std::endl;
-                std::cout << "Processing front " << f + 1 << " with " << front.size() << " individuals" << std::endl;
-                if (front.size() <= 2) {
-                    for (size_t i : front) {
-                        if (i < combined.size()) {
-                            combined[i].crowdingDistance = std::numeric_limits<double>::infinity();
-                        }
-                    }
-                    continue;
-                }
-                std::vector<size_t> sortedFront = front;
-                for (size_t objIdx = 0; objIdx < combined[front[0]].objectives.size(); ++objIdx) {
-                    std::sort(sortedFront.begin(), sortedFront.end(), [&](size_t a, size_t b) {
-                        if (a >= combined.size() || b >= combined.size()) return false;
-                        return combined[a].objectives[objIdx] < combined[b].objectives[objIdx];
-                    });
-                    if (!sortedFront.empty() && sortedFront.front() < combined.size()) {
-                        combined[sortedFront.front()].crowdingDistance = std::numeric_limits<double>::infinity();
-                    }
-                    if (!sortedFront.empty() && sortedFront.back() < combined.size()) {
-                        combined[sortedFront.back()].crowdingDistance = std::numeric_limits<double>::infinity();
-                    }
-                    if (sortedFront.size() <= 2) continue;
-                    double objRange = combined[sortedFront.back()].objectives[objIdx] - combined[sortedFront.front()].objectives[objIdx];
-                    if (std::abs(objRange) < 1e-10) continue;
-                    for (size_t i = 1; i < sortedFront.size() - 1; ++i) {
-                        if (i + 1 < sortedFront.size() && i >= 1 && sortedFront[i] < combined.size() &&
-                            sortedFront[i + 1] < combined.size() && sortedFront[i - 1] < combined.size()) {
-                            combined[sortedFront[i]].crowdingDistance +=
-                                (combined[sortedFront[i + 1]].objectives[objIdx] - combined[sortedFront[i - 1]].objectives[objIdx]) / objRange;
-                        } else {
-                            log << "Warning: Skipping crowding distance for index " << i << " in front " << f + 1 << std::endl;
-                        }
-                    }
-                }
-            }
-
-            // Populate next generation
-            log << "Selecting next generation..." << std::endl;
-            std::cout << "Selecting next generation..." << std::endl;
-            population.clear();
-            frontIdx = 0;
-            while (frontIdx < fronts.size() && population.size() + fronts[frontIdx].size() <= static_cast<size_t>(populationSize)) {
-                log << "Adding front " << frontIdx + 1 << " with " << fronts[frontIdx].size() << " individuals" << std::endl;
-                std::cout << "Adding front " << frontIdx + 1 << " with " << fronts[frontIdx].size() << " individuals" << std::endl;
-                for (size_t i : fronts[frontIdx]) {
-                    if (i < combined.size()) {
-                        population.push_back(combined[i]);
-                    }
-                }
-                frontIdx++;
-            }
-            if (population.size() < static_cast<size_t>(populationSize) && frontIdx < fronts.size()) {
-                log << "Partially adding front " << frontIdx + 1 << " to fill population" << std::endl;
-                std::cout << "Partially adding front " << frontIdx + 1 << " to fill population" << std::endl;
-                std::vector<size_t> sortedFront = fronts[frontIdx];
-                std::sort(sortedFront.begin(), sortedFront.end(), [&](size_t a, size_t b) {
-                    if (a >= combined.size() || b >= combined.size()) return false;
-                    return combined[a].crowdingDistance > combined[b].crowdingDistance;
-                });
-                size_t remaining = populationSize - population.size();
-                log << "Need to add " << remaining << " individuals from front " << frontIdx + 1 << " (size: " << sortedFront.size() << ")" << std::endl;
-                for (size_t i = 0; i < remaining && i < sortedFront.size(); ++i) {
-                    if (sortedFront[i] < combined.size()) {
-                        population.push_back(combined[sortedFront[i]]);
-                    }
-                }
+        SearchHooks<SpindleProblem> hooks = makeSearchHooks(settings, warmStart);
+        hooks.control.stopToken = handle.stopToken();
+        hooks.archive = &archive;
+        hooks.messageSink = [&log](EngineMessage kind, const std::string& message) {
+            if (kind == EngineMessage::Detail) {
+                SPINDLE_LOG_DEBUG(log, message);
+                return;
             }
-            if (population.empty()) {
-                log << "Error: Population is empty after selection" << std::endl;
-                throw std::runtime_error("Population is empty after selection");
+            SPINDLE_LOG_INFO(log, message);
+        };
+        // One log line per generation; the handle keeps the records for other threads
+        hooks.telemetrySink = [&log, &handle](const SpindleTelemetry& record) {
+            handle.record(record);
+            SPINDLE_LOG_INFO(log, "Generation " << record.generation << " [" << searchAlgorithmName(static_cast<SearchAlgorithm>(record.source))
+                << "]: fronts " << record.frontCount << ", first front " << record.firstFrontSize << "/" << record.populationSize
+                << ", hypervolume " << record.hypervolume << ", evaluations " << record.evaluations
+                << ", seconds variation " << record.variationSeconds << " evaluation " << record.evaluationSeconds
+                << " local search " << record.localSearchSeconds << " ranking " << record.rankingSeconds
+                << " selection " << record.selectionSeconds);
+        };
+        std::vector<PointSet> generationFronts;
+        hooks.frontObserver = [&generationFronts](int, const std::vector<SpindleProblem::Objectives>& current) {
+            PointSet rankOne;
+            for (const auto& objectives : current) rankOne.emplace_back(objectives.begin(), objectives.end());
+            generationFronts.push_back(rankOne);
+        };
+        SearchResult<SpindleProblem> result = runSearch(problem, settings, nextSeed(), populationSize, generations, hooks);
+
+        // The true front is unknown, so every generation is measured against the best front seen in the run,
+        // with objectives scaled by the range of every rank-1 point observed. One filter over everything observed
+        // finds that front without re-filtering it once per generation.
+        PointSet observed;
+        for (const auto& points : generationFronts) observed.insert(observed.end(), points.begin(), points.end());
+        PointSet bestKnown = nonDominatedFilter(observed);
+        std::vector<double> ideal(SpindleProblem::objectiveCount, std::numeric_limits<double>::infinity());
+        std::vector<double> nadir(SpindleProblem::objectiveCount, -std::numeric_limits<double>::infinity());
+        for (const auto& point : observed) {
+            for (size_t i = 0; i < point.size(); ++i) {
+                ideal[i] = std::min(ideal[i], point[i]);
+                nadir[i] = std::max(nadir[i], point[i]);
             }
-            log << "New population size: " << population.size() << std::endl;
-            std::cout << "New population size: " << population.size() << std::endl;
         }
+        PointSet normalizedBest = normalizePoints(bestKnown, ideal, nadir);
+        std::vector<FrontMetrics> metricsHistory;
+        for (size_t gen = 0; gen < generationFronts.size(); ++gen) {
+            metricsHistory.push_back(computeFrontMetrics(normalizePoints(generationFronts[gen], ideal, nadir), normalizedBest,
+                                                         std::vector<double>(SpindleProblem::objectiveCount, 1.1), static_cast<int>(gen)));
+        }
+
+        std::vector<ParetoSolution> front = toSolutions(result.front);
+        outcome.status = toOptimizationStatus(result.status);
+        outcome.generationsCompleted = result.generationsCompleted;
+        outcome.evaluations = result.evaluations;
 
         // Output Pareto front (rank 1 solutions)
-        log << "Generating Pareto front output..." << std::endl;
-        std::cout << "Generating Pareto front output..." << std::endl;
         std::stringstream report;
         report << std::fixed << std::setprecision(2);
         report << "=== Pareto-Optimal Spindle Arrangements ===\n\n";
-        report << "Objectives: Minimize Vibration (mm/s), Maximize Bearing Life (hours), Minimize Temperature Rise (°C)\n\n";
+        report << "Objectives: Minimize Vibration (mm/s), Maximize Bearing Life (hours), Minimize Temperature Rise (°C)\n";
+        report << "Search algorithm: " << searchAlgorithmName(settings.algorithm) << "\n";
+        for (const auto& reference : settings.referencePoints) {
+            report << "Reference point: Vibration " << reference[0] << " mm/s, Bearing Life " << reference[1]
+                   << " hours, Temp Rise " << reference[2] << "°C\n";
+        }
+        report << "\n";
         report << std::left;
         report << std::setw(12) << "Vibration" << std::setw(12) << "Bearing Life" << std::setw(12) << "Temp Rise"
                << std::setw(10) << "Power" << std::setw(10) << "Speed" << std::setw(12) << "Wheel Diam"
@@ -942,39 +1084,210 @@ std::string SpindleSimulation::optimizeSpindleArrangement(double duration, doubl
                << std::setw(15) << "Bearing Type" << std::setw(10) << "Cooling" << std::setw(12) << "Lubrication"
                << std::setw(15) << "Tool Interface" << "\n";
 
-        int paretoCount = 0;
-        for (const auto& ind : population) {
-            if (ind.rank != 1) continue;
-            report << std::setw(12) << ind.objectives[0] // Vibration
-                   << std::setw(12) << -ind.objectives[1] // Bearing Life
-                   << std::setw(12) << ind.objectives[2] // Temperature Rise
-                   << std::setw(10) << ind.params.getPowerRating()
-                   << std::setw(10) << ind.params.getMaxSpeed()
-                   << std::setw(12) << ind.params.getWheelDiameter()
-                   << std::setw(10) << ind.params.getBearingPreload()
-                   << std::setw(12) << ind.params.getAlignmentTolerance()
-                   << std::setw(15) << ind.params.getSpindleType()
-                   << std::setw(15) << ind.params.getBearingType()
-                   << std::setw(10) << ind.params.getCoolingType()
-                   << std::setw(12) << ind.params.getLubricationType()
-                   << std::setw(15) << ind.params.getToolInterface()
+        int regionOfInterestCount = 0;
+        for (const auto& solution : front) {
+            for (const auto& reference : settings.referencePoints) {
+                if (solution.vibration <= reference[0] && solution.bearingLife >= reference[1] && solution.temperatureRise <= reference[2]) {
+                    regionOfInterestCount++;
+                    break;
+                }
+            }
+            const SpindleParameters& params = solution.params;
+            report << std::setw(12) << solution.vibration
+                   << std::setw(12) << solution.bearingLife
+                   << std::setw(12) << solution.temperatureRise
+                   << std::setw(10) << params.getPowerRating()
+                   << std::setw(10) << params.getMaxSpeed()
+                   << std::setw(12) << params.getWheelDiameter()
+                   << std::setw(10) << params.getBearingPreload()
+                   << std::setw(12) << params.getAlignmentTolerance()
+                   << std::setw(15) << params.getSpindleType()
+                   << std::setw(15) << params.getBearingType()
+                   << std::setw(10) << params.getCoolingType()
+                   << std::setw(12) << params.getLubricationType()
+                   << std::setw(15) << params.getToolInterface()
                    << "\n";
-            paretoCount++;
         }
-        report << "\nTotal Pareto-optimal solutions found: " << paretoCount << "\n";
-        log << "Optimization complete, found " << paretoCount << " Pareto-optimal solutions" << std::endl;
-        std::cout << "Optimization complete, found " << paretoCount << " Pareto-optimal solutions" << std::endl;
-        log.close();
-        return report.str();
+        report << "\nTotal Pareto-optimal solutions found: " << front.size() << "\n";
+        if (outcome.status != OptimizationStatus::Completed) {
+            report << (outcome.status == OptimizationStatus::Cancelled ? "Cancelled" : "Time limit reached") << " after "
+                   << result.generationsCompleted << " of " << generations << " generations; this is the best front found so far\n";
+        }
+        if (!settings.frontExportPath.empty()) {
+            writeFrontFile(settings.frontExportPath, front);
+            report << "Pareto front written to: " << settings.frontExportPath << "\n";
+        }
+        if (!settings.referencePoints.empty()) {
+            report << "Solutions meeting at least one reference point: " << regionOfInterestCount << "\n";
+        }
+        report << "Evaluations: " << result.evaluations << "\n";
+        for (const auto& note : result.notes) report << note << "\n";
+        if (!metricsHistory.empty()) {
+            // Objectives normalized by the ideal and nadir of the best front found
+            const FrontMetrics& last = metricsHistory.back();
+            report << "\nFront quality (normalized by all rank-1 points seen, against the best front found):\n";
+            report << std::setprecision(4);
+            report << "Hypervolume: " << last.hypervolume << ", IGD: " << last.igd << ", IGD+: " << last.igdPlus
+                   << ", Epsilon: " << last.epsilon << "\n";
+            report << "Spacing: " << last.spacing << ", Spread: " << last.spread << "\n";
+            report << std::setprecision(2);
+        }
+        if (!settings.metricsExportPath.empty()) {
+            writeFrontMetrics(settings.metricsExportPath, metricsHistory);
+            report << "Per-generation metrics written to: " << settings.metricsExportPath << "\n";
+        }
+        SPINDLE_LOG_INFO(log, "Optimization complete, found " << front.size() << " Pareto-optimal solutions");
+        outcome.front = std::move(front);
+        outcome.report = report.str();
     } catch (const std::exception& e) {
-        log << "Error in optimizeSpindleArrangement: " << e.what() << std::endl;
-        std::cerr << "Error in optimizeSpindleArrangement: " << e.what() << std::endl;
-        log.close();
-        return "Error: Optimization failed - " + std::string(e.what()) + "\n";
+        SPINDLE_LOG_ERROR(log, "Error in optimizeSpindleArrangement: " << e.what());
+        outcome.status = OptimizationStatus::Failed;
+        outcome.error = e.what();
+        outcome.front = toSolutions(archive.snapshot());
     } catch (...) {
-        log << "Unknown error in optimizeSpindleArrangement" << std::endl;
-        std::cerr << "Unknown error in optimizeSpindleArrangement" << std::endl;
-        log.close();
-        return "Error: Optimization failed - Unknown error\n";
+        SPINDLE_LOG_ERROR(log, "Unknown error in optimizeSpindleArrangement");
+        outcome.status = OptimizationStatus::Failed;
+        outcome.error = "Unknown error";
+        outcome.front = toSolutions(archive.snapshot());
     }
-}
\ No newline at end of file
+    log.flush();
+    outcome.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    handle.detach(outcome.front);
+    return outcome;
+}
+
+std::string SpindleSimulation::runReplicateStudy(const std::string& jobPath) {
+    try {
+        ReplicateJob job = loadReplicateJob(jobPath);
+        std::vector<SpindleParameters> warmStart;
+        if (!job.settings.warmStartPath.empty()) warmStart = loadFrontFile(job.settings.warmStartPath);
+
+        // Replicate drivers only wait on evaluations; unless the job pins per-run pools, every replicate's evaluations
+        // go to the shared work-stealing executor, which balances them across the cores
+        size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        size_t concurrent = std::min(job.concurrentRuns > 0 ? job.concurrentRuns : hardware, static_cast<size_t>(job.replicates));
+        const OptimizationSettings& runSettings = job.settings;
+
+        struct ReplicateOutcome {
+            unsigned int seed;
+            std::vector<ParetoSolution> front;
+            PointSet objectives;  // Minimized objective space (bearing life negated)
+            double seconds;
+            size_t evaluations;
+            int generationsCompleted;  // Below the job's generations when the time limit stopped the replicate
+        };
+
+        SpindleProblem problem(*this, job.duration, job.loadFactor, &optimizationLog());
+        std::vector<ReplicateOutcome> outcomes;
+        {
+            ThreadPool runner(concurrent);
+            std::vector<std::future<ReplicateOutcome>> pending;
+            for (int r = 0; r < job.replicates; ++r) {
+                unsigned int seed = job.baseSeed + static_cast<unsigned int>(r);
+                pending.push_back(runner.submit([&problem, &runSettings, &warmStart, &job, seed]() {
+                    auto start = std::chrono::steady_clock::now();
+                    SearchResult<SpindleProblem> result = runSearch(problem, runSettings, seed, job.populationSize, job.generations,
+                                                                    makeSearchHooks(runSettings, warmStart));
+                    ReplicateOutcome outcome{seed, {}, {}, 0.0, result.evaluations, result.generationsCompleted};
+                    outcome.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    outcome.front = toSolutions(result.front);
+                    for (const auto& entry : result.front) outcome.objectives.emplace_back(entry.objectives.begin(), entry.objectives.end());
+                    return outcome;
+                }));
+            }
+            for (auto& replicate : pending) outcomes.push_back(replicate.get());
+        }
+
+        // Hypervolumes are comparable because every replicate is normalized by the same ideal and nadir
+        std::vector<PointSet> runs;
+        PointSet pooled;
+        std::vector<const ParetoSolution*> pooledSolutions;
+        for (const auto& outcome : outcomes) {
+            runs.push_back(outcome.objectives);
+            pooled.insert(pooled.end(), outcome.objectives.begin(), outcome.objectives.end());
+            for (const auto& solution : outcome.front) pooledSolutions.push_back(&solution);
+        }
+        std::vector<double> ideal(SpindleProblem::objectiveCount, std::numeric_limits<double>::infinity());
+        std::vector<double> nadir(SpindleProblem::objectiveCount, -std::numeric_limits<double>::infinity());
+        for (const auto& point : pooled) {
+            for (size_t i = 0; i < point.size(); ++i) {
+                ideal[i] = std::min(ideal[i], point[i]);
+                nadir[i] = std::max(nadir[i], point[i]);
+            }
+        }
+        const std::vector<double> referencePoint(SpindleProblem::objectiveCount, 1.1);
+        std::vector<double> volumes;
+        std::vector<double> times;
+        for (const auto& outcome : outcomes) {
+            volumes.push_back(hypervolume(normalizePoints(outcome.objectives, ideal, nadir), referencePoint));
+            times.push_back(outcome.seconds);
+        }
+
+        std::vector<ParetoSolution> merged;
+        for (const auto& point : nonDominatedFilter(pooled)) {
+            for (size_t i = 0; i < pooled.size(); ++i) {
+                if (pooled[i] == point) {
+                    merged.push_back(*pooledSolutions[i]);
+                    break;
+                }
+            }
+        }
+
+        std::stringstream report;
+        report << std::fixed << std::setprecision(2);
+        report << "=== Replicate Optimization Study ===\n\n";
+        report << "Job: " << jobPath << "\n";
+        report << "Replicates: " << job.replicates << " (seeds " << job.baseSeed << "-" << job.baseSeed + job.replicates - 1
+               << "), concurrent runs: " << concurrent << ", evaluation threads: ";
+        if (runSettings.workerThreads > 0) report << runSettings.workerThreads << " per run\n";
+        else report << ThreadPool::shared().size() << " shared\n";
+        report << "Search algorithm: " << searchAlgorithmName(runSettings.algorithm) << "\n";
+        report << "Population: " << job.populationSize << ", generations: " << job.generations << ", duration: " << job.duration
+               << " s, load factor: " << job.loadFactor << "\n\n";
+
+        report << std::left << std::setw(8) << "Seed" << std::setw(12) << "Front Size" << std::setw(14) << "Hypervolume"
+               << std::setw(16) << "Wall-Clock (s)" << std::setw(12) << "Evaluations" << "\n";
+        for (size_t r = 0; r < outcomes.size(); ++r) {
+            report << std::setw(8) << outcomes[r].seed << std::setw(12) << outcomes[r].front.size()
+                   << std::setw(14) << std::setprecision(4) << volumes[r]
+                   << std::setw(16) << std::setprecision(2) << outcomes[r].seconds << std::setw(12) << outcomes[r].evaluations << "\n";
+        }
+        report << std::setprecision(4);
+        report << "\nHypervolume (normalized over all replicates): median " << quantile(volumes, 0.5)
+               << ", IQR [" << quantile(volumes, 0.25) << ", " << quantile(volumes, 0.75) << "]\n";
+        report << "Wall-clock (s): median " << quantile(times, 0.5)
+               << ", IQR [" << quantile(times, 0.25) << ", " << quantile(times, 0.75) << "]\n";
+        size_t stopped = std::count_if(outcomes.begin(), outcomes.end(), [&job](const ReplicateOutcome& outcome) {
+            return outcome.generationsCompleted < job.generations;
+        });
+        if (stopped > 0) {
+            report << "Replicates stopped by the time limit: " << stopped << " of " << outcomes.size() << "\n";
+        }
+
+        report << "\nAttainment surfaces (points attained by at least k runs):\n";
+        const std::pair<const char*, size_t> levels[] = {
+            {"Best", 1}, {"Median", static_cast<size_t>(job.replicates + 1) / 2}, {"Worst", static_cast<size_t>(job.replicates)}
+        };
+        for (const auto& level : levels) {
+            PointSet surface = attainmentSurface(runs, level.second);
+            report << level.first << " (k = " << level.second << "): " << surface.size() << " points, hypervolume "
+                   << hypervolume(normalizePoints(surface, ideal, nadir), referencePoint) << "\n";
+        }
+
+        report << std::setprecision(2);
+        report << "\nMerged front: " << merged.size() << " non-dominated solutions from " << pooled.size() << " replicate solutions\n";
+        report << std::setw(12) << "Vibration" << std::setw(16) << "Bearing Life" << std::setw(12) << "Temp Rise"
+               << std::setw(15) << "Spindle Type" << std::setw(15) << "Bearing Type" << "\n";
+        for (const auto& solution : merged) {
+            report << std::setw(12) << solution.vibration << std::setw(16) << solution.bearingLife << std::setw(12) << solution.temperatureRise
+                   << std::setw(15) << solution.params.getSpindleType() << std::setw(15) << solution.params.getBearingType() << "\n";
+        }
+        if (!job.mergedFrontPath.empty()) {
+            writeFrontFile(job.mergedFrontPath, merged);
+            report << "Merged front written to: " << job.mergedFrontPath << "\n";
+        }
+        return report.str();
+    } catch (const std::exception& e) {
+        return "Error: Replicate study failed - " + std::string(e.what()) + "\n";
+    }
+}
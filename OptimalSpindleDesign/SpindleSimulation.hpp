@@ -2,23 +2,138 @@
 #define SPINDLE_SIMULATION_HPP
 
 #include "SpindleParameters.hpp"
+#include "OptimizationSettings.hpp"
+#include "HistoryImport.hpp"
+#include "MaintenanceClassifier.hpp"
+#include "MaintenanceHistory.hpp"
+#include "Telemetry.hpp"
+#include "AsyncTask.hpp"
+#include "AsyncGenerator.hpp"
+#include <atomic>
+#include <functional>
+#include <iosfwd>
+#include <mutex>
+#include <optional>
 #include <vector>
 #include <string>
 #include <random>
+#include <span>
+#include <stop_token>
 
+// Rank-1 configuration returned by the optimizer, with objectives in report units
+struct ParetoSolution {
+    SpindleParameters params;
+    double vibration;
+    double bearingLife;
+    double temperatureRise;
+    ParetoSolution(const SpindleParameters& p, double vib, double life, double temp)
+        : params(p), vibration(vib), bearingLife(life), temperatureRise(temp) {}
+};
+
+// Continuous parameter varied by SpindleSimulation::sweepParameter
+enum class SweepVariable {
+    PowerRating,
+    MaxSpeed,
+    WheelDiameter,
+    BearingPreload,
+    AlignmentTolerance
+};
+
+// One configuration of a parameter sweep with its simulated performance, in report units
+struct SweepPoint {
+    SpindleParameters params;
+    double value = 0.0;  // Swept parameter value
+    double vibration = 0.0;
+    double temperatureRise = 0.0;
+    double bearingLife = 0.0;
+    double spindleLife = 0.0;
+    double wheelWear = 0.0;
+    int maintenanceNeeded = 0;
+};
+
+// Objectives in engine order: vibration, negated bearing life, temperature rise
+using SpindleTelemetry = GenerationTelemetry<3>;
+
+enum class OptimizationStatus {
+    Completed,        // Every requested generation ran
+    Cancelled,        // OptimizationHandle::cancel was called
+    DeadlineReached,  // OptimizationSettings::timeLimitSeconds ran out
+    Failed            // An exception ended the run; error holds the reason
+};
+
+// Outcome of an anytime optimization. The front is the best found so far whatever the status.
+struct OptimizationResult {
+    OptimizationStatus status = OptimizationStatus::Completed;
+    std::vector<ParetoSolution> front;
+    int generationsCompleted = 0;
+    size_t evaluations = 0;
+    double seconds = 0.0;
+    std::string report;  // Formatted report, empty on failure
+    std::string error;
+};
+
+// One streamed interval of a time-based simulation, with the state at its last step
+struct TimeBasedProgress {
+    int step = 0;            // Steps completed so far
+    int totalSteps = 0;
+    double time = 0.0;       // Simulated seconds
+    double vibration = 0.0;
+    double temperature = 0.0;
+    double load = 0.0;
+    std::optional<std::string> report;  // Set on the last record only
+};
+
+// One streamed generation of an optimization; the last record carries the outcome instead
+struct OptimizationProgress {
+    std::optional<SpindleTelemetry> generation;
+    std::optional<OptimizationResult> result;
+};
+
+// Shared between a running optimization and other threads: requests cancellation and reads the best-so-far front
+class OptimizationHandle {
+private:
+    std::stop_source stopSource;
+    mutable std::mutex mutex;
+    std::function<std::vector<ParetoSolution>()> liveFront;  // Set while a run is active
+    std::vector<ParetoSolution> finalFront;
+    TelemetryRing<SpindleTelemetry> telemetryRing;
+    std::function<void(const SpindleTelemetry&)> listener;
+
+public:
+    void cancel() { stopSource.request_stop(); }
+    bool cancelRequested() const { return stopSource.stop_requested(); }
+    std::stop_token stopToken() const { return stopSource.get_token(); }
+
+    // Current archive contents while a run is active, its final front afterwards; callable from any thread
+    std::vector<ParetoSolution> snapshot() const;
+
+    // Latest per-generation records of the current or last run, oldest first; callable from any thread
+    std::vector<SpindleTelemetry> telemetry() const { return telemetryRing.records(); }
+
+    // Called with every later record on the optimizer's threads; pass nullptr to stop
+    void setListener(std::function<void(const SpindleTelemetry&)> callback);
+
+    // Called by the optimizer around and during a run
+    void attach(std::function<std::vector<ParetoSolution>()> source);
+    void detach(const std::vector<ParetoSolution>& front);
+    void record(const SpindleTelemetry& generation);
+};
+
+// Mutable state of one simulation thread: its random stream and scratch buffers reused from call to call
+struct EvaluationContext {
+    std::mt19937 rng;
+    std::vector<double> loadProfile;
+    std::vector<double> vibrationHistory;
+    std::vector<double> temperatureHistory;
+    explicit EvaluationContext(unsigned int seed) : rng(seed) {}
+};
+
+// The model itself is immutable, so any number of threads may simulate and optimize on one instance. Randomness
+// comes from an EvaluationContext (a fresh one per call unless the caller passes its own) and the maintenance
+// history synchronizes its own appends.
 class SpindleSimulation {
 private:
-    struct DataPoint {
-        double vibration;
-        double temperature;
-        double load;
-        double bearingLife;
-        double spindleLife;
-        double wheelWear;
-        int label; // 1 = maintenance needed, 0 = no maintenance
-        DataPoint(double vib, double temp, double ld, double bLife, double sLife, double wWear, int lbl)
-            : vibration(vib), temperature(temp), load(ld), bearingLife(bLife), spindleLife(sLife), wheelWear(wWear), label(lbl) {}
-    };
+    using DataPoint = MaintenanceRecord;
 
     struct SimulationScenario {
         std::string name;
@@ -29,41 +144,46 @@ private:
             : name(n), speedFactor(sf), loadFactor(lf), duration(d) {}
     };
 
-    // MOGA-related structures
-    struct Individual {
-        SpindleParameters params;
-        std::vector<double> objectives; // [vibration, -bearingLife, temperature]
-        int rank;
-        double crowdingDistance;
-        Individual() : rank(0), crowdingDistance(0.0) {}
-    };
-
-    static std::vector<DataPoint> historicalData;
-    mutable std::mt19937 rng; // Mutable to allow use in const methods
+    unsigned int baseSeed;
+    mutable std::atomic<unsigned int> contextCount;  // Contexts handed out so far; mixed into each context's seed
+    MaintenanceHistory history;
+    std::atomic<std::shared_ptr<const MaintenanceClassifier>> classifier;  // Null: nearest-neighbour prediction
 
     std::string validateParameters(const SpindleParameters& params) const;
     std::string evaluateSpindleType(const SpindleParameters& params) const;
     std::string evaluateBearingPerformance(const SpindleParameters& params) const;
     double calculateThermalExpansion(double tempRise) const;
     double calculateResonanceFrequency(const SpindleParameters& params) const;
-    std::string runSimulationStage(const SpindleParameters& params, const SimulationScenario& scenario);
-    std::string generateComprehensiveReport(const SpindleParameters& params, const std::vector<SimulationScenario>& scenarios);
-    void generateHistoricalData();
-    double calculateEuclideanDistance(const DataPoint& p1, const DataPoint& p2) const;
+    std::string runSimulationStage(const SpindleParameters& params, const SimulationScenario& scenario, EvaluationContext& context);
+    std::string generateComprehensiveReport(const SpindleParameters& params, const std::vector<SimulationScenario>& scenarios,
+                                            EvaluationContext& context) const;
+    // simulateTimeBased in pieces, so the streaming variant can yield between intervals; begin returns the step count
+    int beginTimeBased(const SpindleParameters& params, double duration, EvaluationContext& context, std::ostream& results) const;
+    void advanceTimeBased(const SpindleParameters& params, int first, int last, double& temperature, EvaluationContext& context,
+                          std::ostream& results) const;
+    void finishTimeBased(const SpindleParameters& params, double duration, EvaluationContext& context, std::ostream& results);
+    void generateHistoricalData(std::mt19937& rng);
+    unsigned int nextSeed() const;
 
     // MOGA-related methods
-    void evaluateObjectives(Individual& ind, double duration, double loadFactor);
-    bool dominates(const Individual& a, const Individual& b) const;
-    void nonDominatedSorting(std::vector<Individual>& population);
-    double calculateCrowdingDistance(const std::vector<Individual>& front, size_t objIdx) const;
-    Individual crossover(const Individual& parent1, const Individual& parent2);
-    void mutate(Individual& ind);
-    SpindleParameters generateRandomParameters();
+    std::vector<SpindleParameters> loadFrontFile(const std::string& path) const;
+    void writeFrontFile(const std::string& path, const std::vector<ParetoSolution>& front) const;
 
 public:
     SpindleSimulation();
+    // Reproducible history and per-call random streams; retention bounds the maintenance history or, with a store
+    // directory, persists it
+    explicit SpindleSimulation(unsigned int seed, const HistoryRetention& retention = HistoryRetention());
+    SpindleSimulation(const SpindleSimulation&) = delete;
+    SpindleSimulation& operator=(const SpindleSimulation&) = delete;
+
+    // A context with its own stream of this simulation's seed sequence; keep one per thread to reuse its buffers
+    EvaluationContext makeContext() const { return EvaluationContext(nextSeed()); }
+
     std::string simulate(const SpindleParameters& params);
+    std::string simulate(const SpindleParameters& params, EvaluationContext& context);
     std::string simulateTimeBased(const SpindleParameters& params, double duration);
+    std::string simulateTimeBased(const SpindleParameters& params, double duration, EvaluationContext& context);
     std::string generateMaintenanceSchedule(const SpindleParameters& params);
     double calculateRequiredPower(double wheelDiameter, int speed) const;
     double estimateTemperatureRise(const SpindleParameters& params) const;
@@ -72,12 +192,67 @@ public:
     double estimateVibration(const SpindleParameters& params, double load) const;
     double estimateLoad(const SpindleParameters& params) const;
     std::vector<double> generateDynamicLoadProfile(const SpindleParameters& params, double duration, double loadFactor) const;
+    std::vector<double> generateDynamicLoadProfile(const SpindleParameters& params, double duration, double loadFactor, std::mt19937& generator) const;
+    // Fills profile in place so callers can reuse its capacity
+    void generateDynamicLoadProfile(const SpindleParameters& params, double duration, double loadFactor, std::mt19937& generator,
+                                    std::vector<double>& profile) const;
     double calculateBearingL10Life(const SpindleParameters& params, const std::vector<double>& loadProfile) const;
     double calculateSpindleFatigueLife(const SpindleParameters& params, const std::vector<double>& loadProfile) const;
     double calculateWheelWear(const SpindleParameters& params, const std::vector<double>& loadProfile, double duration) const;
     double calculateWearInducedVibration(const SpindleParameters& params, double wear) const;
-    int predictMaintenance(double vibration, double temperature, double load, double bearingLife, double spindleLife, double wheelWear);
+    int predictMaintenance(double vibration, double temperature, double load, double bearingLife, double spindleLife, double wheelWear) const;
+
+    // Batch workloads run on the shared work-stealing executor (ThreadPool::shared) and return results in input order
+    std::vector<std::string> simulateBatch(const std::vector<SpindleParameters>& configurations);
+    // steps evenly spaced values of one parameter from..to, the rest taken from base; throws if a value is out of range
+    std::vector<SweepPoint> sweepParameter(const SpindleParameters& base, SweepVariable variable, double from, double to, int steps,
+                                           double duration, double loadFactor) const;
+    // One label per query row. With neighborDistances, also the scaled-feature distances to the k = 3 nearest
+    // records, row-major and closest first (infinity where the history holds fewer than k); a trained classifier
+    // finds no neighbours and leaves it empty.
+    std::vector<int> predictMaintenanceBatch(std::span<const MaintenanceRecord> queries,
+                                             std::vector<float>* neighborDistances = nullptr) const;
+    // Maintenance prediction at every 0.1 s step of a time-based run, from the step's vibration, temperature and
+    // load and the wheel wear accumulated so far. Throws std::invalid_argument for a duration shorter than one step.
+    std::vector<int> predictMaintenanceTimeSeries(const SpindleParameters& params, double duration,
+                                                  std::vector<float>* neighborDistances = nullptr);
+    // Appends the rows of a CSV or sensor log to the maintenance history (see importMaintenanceCsv)
+    HistoryImportReport importMaintenanceHistory(const std::string& path, const HistoryImportOptions& options = HistoryImportOptions());
+    // Recall and mean query time of the history's neighbour index against exact search, over sampleCount queries at
+    // midpoints of random pairs of stored records, k = 3 as in predictMaintenance
+    NeighborRecall measureMaintenanceRecall(size_t sampleCount = 1000) const;
+    // Trains settings.model on a snapshot of the maintenance history and switches predictMaintenance and the batch
+    // predictions over to it; MaintenanceModel::Neighbors switches back to the history's nearest neighbours and
+    // returns null. A trained model does not learn from later appends until it is trained again.
+    std::shared_ptr<const MaintenanceClassifier> trainMaintenanceModel(const ClassifierSettings& settings = ClassifierSettings());
+    MaintenanceModel maintenanceModel() const;
+    // Recall/latency trade-off and persistence of a history built with NeighborSearch::Hnsw
+    void setMaintenanceSearchBreadth(size_t breadth) { history.setSearchBreadth(breadth); }
+    void saveMaintenanceIndex(const std::string& path = std::string()) const { history.saveNeighborIndex(path); }
     std::string optimizeSpindleArrangement(double duration, double loadFactor, int populationSize, int generations);
+    std::string optimizeSpindleArrangement(double duration, double loadFactor, int populationSize, int generations,
+                                           const OptimizationSettings& settings);
+    // Anytime variant: once the handle is cancelled or the time limit passes, evaluations that have not started are
+    // skipped and the run returns within the current generation, with the best-so-far front instead of an error string
+    OptimizationResult optimizeSpindleArrangement(double duration, double loadFactor, int populationSize, int generations,
+                                                  const OptimizationSettings& settings, OptimizationHandle& handle);
+
+    // Coroutine API. Each call launches its work on the shared executor and returns at once; the simulation and any
+    // handle passed by reference must outlive the task or stream. Arguments are taken by value into the coroutine frame.
+    Task<std::string> simulateAsync(SpindleParameters params);
+    Task<std::string> simulateTimeBasedAsync(SpindleParameters params, double duration);
+    Task<OptimizationResult> optimizeSpindleArrangementAsync(double duration, double loadFactor, int populationSize, int generations,
+                                                             OptimizationSettings settings, OptimizationHandle& handle);
+    // Progress streams start when first pulled. A time-based stream yields every interval steps and its last record
+    // carries the report; an optimization stream yields each generation's telemetry and then the result. The run
+    // shares ownership of its handle (one is created when none is given), and destroying the stream before the
+    // result cancels it; the run still uses the simulation until it stops, within its current generation.
+    AsyncGenerator<TimeBasedProgress> simulateTimeBasedStream(SpindleParameters params, double duration, int interval = 10);
+    AsyncGenerator<OptimizationProgress> optimizeSpindleArrangementStream(double duration, double loadFactor, int populationSize,
+                                                                          int generations, OptimizationSettings settings,
+                                                                          std::shared_ptr<OptimizationHandle> handle = nullptr);
+    // Runs the replicate study described by a job file (see ReplicateJob.hpp) and returns one consolidated report
+    std::string runReplicateStudy(const std::string& jobPath);
 };
 
 #endif // SPINDLE_SIMULATION_HPP
\ No newline at end of file
@@ -0,0 +1,161 @@
+#ifndef TELEMETRY_HPP
+#define TELEMETRY_HPP
+
+#include "ParetoMetrics.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+// Structured per-generation engine telemetry. Engines only read clocks and build records while a sink is installed,
+// so a run without telemetry pays a branch per phase.
+
+template<std::size_t M>
+struct GenerationTelemetry {
+    int generation = 0;           // 0 is the initial population
+    int source = 0;               // SearchAlgorithm of the reporting engine (several report in a portfolio)
+    size_t populationSize = 0;
+    size_t frontCount = 0;        // Non-dominated fronts in the population (1 for archive-based engines)
+    size_t firstFrontSize = 0;
+    double hypervolume = 0.0;     // First front scaled by the initial population's range, reference point 1.1
+    size_t evaluations = 0;       // Cumulative count of the engine's evaluator
+
+    // Wall-clock seconds spent in each phase of this generation
+    double variationSeconds = 0.0;
+    double evaluationSeconds = 0.0;
+    double localSearchSeconds = 0.0;  // Waiting for memetic refinements beyond the offspring evaluation
+    double rankingSeconds = 0.0;
+    double selectionSeconds = 0.0;
+
+    std::array<double, M> objectiveMin{};
+    std::array<double, M> objectiveMean{};
+    std::array<double, M> objectiveMax{};
+
+    // Success-history state after this generation (NSGA-II only)
+    double crossoverAlpha = 0.0;
+    double mutationEta = 0.0;
+    double mutationRate = 0.0;
+    size_t offspringSurvivors = 0;    // Offspring that reached the first front
+};
+
+template<std::size_t M>
+using TelemetrySink = std::function<void(const GenerationTelemetry<M>&)>;
+
+// Fixed-capacity ring holding the latest records; one thread may push while others read
+template<typename Record>
+class TelemetryRing {
+private:
+    std::vector<Record> slots;
+    size_t next;
+    size_t stored;
+    mutable std::mutex mutex;
+
+public:
+    explicit TelemetryRing(size_t capacity = 256) : slots(std::max<size_t>(1, capacity)), next(0), stored(0) {}
+
+    void push(const Record& record) {
+        std::lock_guard<std::mutex> lock(mutex);
+        slots[next] = record;
+        next = (next + 1) % slots.size();
+        stored = std::min(stored + 1, slots.size());
+    }
+
+    // Oldest first
+    std::vector<Record> records() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<Record> ordered;
+        ordered.reserve(stored);
+        for (size_t i = 0; i < stored; ++i) ordered.push_back(slots[(next + slots.size() - stored + i) % slots.size()]);
+        return ordered;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        next = 0;
+        stored = 0;
+    }
+};
+
+// Builds one engine's records: phase laps accumulate into the current record and publish() completes and emits it
+template<std::size_t M>
+class TelemetryRecorder {
+public:
+    using Record = GenerationTelemetry<M>;
+
+private:
+    TelemetrySink<M> sink;
+    Record record;
+    std::chrono::steady_clock::time_point mark;
+    std::array<double, M> scaleIdeal{};
+    std::array<double, M> scaleRange{};
+    bool scaled = false;
+
+public:
+    void setSink(TelemetrySink<M> target) { sink = std::move(target); }
+    bool enabled() const { return static_cast<bool>(sink); }
+    Record& current() { return record; }
+
+    // Starts timing a generation
+    void begin() {
+        if (!sink) return;
+        record = Record();
+        mark = std::chrono::steady_clock::now();
+    }
+
+    // Charges the time since the previous mark to one phase field
+    void lap(double Record::* phase) {
+        if (!sink) return;
+        auto now = std::chrono::steady_clock::now();
+        record.*phase += std::chrono::duration<double>(now - mark).count();
+        mark = now;
+    }
+
+    // Items need objectives; a rank member (1 = first front) is used when present, otherwise every item is non-dominated
+    template<typename Items>
+    void publish(int generation, const Items& items, size_t evaluations) {
+        if (!sink || items.empty()) return;
+        record.generation = generation;
+        record.populationSize = items.size();
+        record.evaluations = evaluations;
+        record.objectiveMin.fill(std::numeric_limits<double>::infinity());
+        record.objectiveMax.fill(-std::numeric_limits<double>::infinity());
+        record.objectiveMean.fill(0.0);
+
+        PointSet firstFront;
+        int deepestRank = 1;
+        for (const auto& item : items) {
+            for (size_t i = 0; i < M; ++i) {
+                record.objectiveMin[i] = std::min(record.objectiveMin[i], item.objectives[i]);
+                record.objectiveMax[i] = std::max(record.objectiveMax[i], item.objectives[i]);
+                record.objectiveMean[i] += item.objectives[i] / items.size();
+            }
+            int rank = 1;
+            if constexpr (requires { item.rank; }) rank = item.rank;
+            deepestRank = std::max(deepestRank, rank);
+            if (rank == 1) firstFront.emplace_back(item.objectives.begin(), item.objectives.end());
+        }
+        record.frontCount = static_cast<size_t>(deepestRank);
+        record.firstFrontSize = firstFront.size();
+
+        // The first published population fixes the scale so hypervolumes are comparable across generations
+        if (!scaled) {
+            for (size_t i = 0; i < M; ++i) {
+                scaleIdeal[i] = record.objectiveMin[i];
+                double range = record.objectiveMax[i] - record.objectiveMin[i];
+                scaleRange[i] = range > 1e-12 ? range : 1.0;
+            }
+            scaled = true;
+        }
+        for (auto& point : firstFront) {
+            for (size_t i = 0; i < M; ++i) point[i] = (point[i] - scaleIdeal[i]) / scaleRange[i];
+        }
+        record.hypervolume = hypervolume(firstFront, std::vector<double>(M, 1.1));
+        sink(record);
+    }
+};
+
+#endif // TELEMETRY_HPP
@@ -0,0 +1,141 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+// Identifies the pool and deque of the current thread when it is a worker
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentWorker = 0;
+
+std::mutex sharedMutex;
+std::unique_ptr<ThreadPool> sharedPool;
+size_t sharedThreadCount = 0;
+bool sharedPinThreads = false;
+
+void pinToCore(std::thread& thread, size_t index) {
+#ifdef __linux__
+    size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<int>(index % cores), &set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+    (void)thread;
+    (void)index;
+#endif
+}
+}
+
+ThreadPool::ThreadPool(size_t threadCount, bool pinThreads) : injectedCount(0), queued(0), nextWorker(0), stopping(false) {
+    if (threadCount == 0) threadCount = 1;
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) workers.push_back(std::make_unique<Worker>());
+    // Deques exist before any thread starts, so early steals never see a half-built pool
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers[i]->thread = std::thread([this, i]() { workerLoop(i); });
+        if (pinThreads) pinToCore(workers[i]->thread, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+}
+
+bool ThreadPool::isWorkerThread() const {
+    return currentPool == this;
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    size_t target = isWorkerThread() ? currentWorker : nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+    {
+        std::lock_guard<std::mutex> lock(workers[target]->mutex);
+        workers[target]->tasks.push_back(std::move(task));
+        queued.fetch_add(1);
+    }
+    // Taking the sleep mutex orders this push against a worker that is about to wait
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wake.notify_one();
+}
+
+void ThreadPool::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(injectedMutex);
+        injected.push_back(std::move(task));
+        injectedCount.fetch_add(1);
+        queued.fetch_add(1);
+    }
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wake.notify_one();
+}
+
+bool ThreadPool::runOne() {
+    std::function<void()> task;
+    size_t start = isWorkerThread() ? currentWorker : 0;
+    if (injectedCount.load() > 0) {
+        std::lock_guard<std::mutex> lock(injectedMutex);
+        if (!injected.empty()) {
+            task = std::move(injected.front());
+            injected.pop_front();
+            injectedCount.fetch_sub(1);
+            queued.fetch_sub(1);
+        }
+    }
+    if (!task && isWorkerThread()) {
+        Worker& own = *workers[start];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued.fetch_sub(1);
+        }
+    }
+    for (size_t k = 1; !task && k <= workers.size(); ++k) {
+        Worker& victim = *workers[(start + k) % workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        queued.fetch_sub(1);
+    }
+    if (!task) return false;
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentWorker = index;
+    while (true) {
+        if (runOne()) continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    if (!sharedPool) {
+        size_t threads = sharedThreadCount > 0 ? sharedThreadCount : std::max(1u, std::thread::hardware_concurrency());
+        sharedPool = std::make_unique<ThreadPool>(threads, sharedPinThreads);
+    }
+    return *sharedPool;
+}
+
+bool ThreadPool::configureShared(size_t threadCount, bool pinThreads) {
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    if (sharedPool) return false;
+    sharedThreadCount = threadCount;
+    sharedPinThreads = pinThreads;
+    return true;
+}
@@ -0,0 +1,85 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Work-stealing executor. Every worker owns a deque: it runs its own tasks newest first and, when that runs dry,
+// steals the oldest task of another worker. Tasks submitted from a worker stay on its deque; submissions from
+// outside the pool are dealt round-robin. A worker waiting on a future through wait() keeps running queued tasks,
+// so tasks may submit and wait on subtasks without starving the pool. Posted tasks go to a shared FIFO injection
+// queue that every worker drains before its own deque, so a coroutine resumed from inside a busy run is not stuck
+// behind the batches that run queues after it.
+class ThreadPool {
+private:
+    struct Worker {
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::deque<std::function<void()>> injected;  // Posted tasks, oldest first
+    std::mutex injectedMutex;
+    std::atomic<size_t> injectedCount;           // Lets runOne() skip the injection lock while nothing is posted
+    std::atomic<size_t> queued;      // Tasks waiting in any deque
+    std::atomic<size_t> nextWorker;  // Round-robin target for outside submissions
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    bool stopping;
+
+    void workerLoop(size_t index);
+    void enqueue(std::function<void()> task);
+    bool runOne();   // Runs one queued task on the calling thread; false when every deque is empty
+    bool isWorkerThread() const;
+
+public:
+    // pinThreads binds worker i to CPU i modulo the core count (Linux only; ignored elsewhere)
+    explicit ThreadPool(size_t threadCount = std::thread::hardware_concurrency(), bool pinThreads = false);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    template<typename F>
+    auto submit(F&& task) -> std::future<std::invoke_result_t<F>> {
+        using Result = std::invoke_result_t<F>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> result = packaged->get_future();
+        enqueue([packaged]() { (*packaged)(); });
+        return result;
+    }
+
+    // Fire-and-forget submission for callers that track completion themselves, such as coroutine resumption. Runs
+    // ahead of every task queued with submit(), in posting order.
+    void post(std::function<void()> task);
+
+    // Returns the future's value. On a worker of this pool the wait runs other queued tasks; elsewhere it blocks.
+    template<typename T>
+    T wait(std::future<T>& result) {
+        if (isWorkerThread()) {
+            while (result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                if (!runOne()) result.wait_for(std::chrono::microseconds(200));
+            }
+        }
+        return result.get();
+    }
+
+    // Process-wide executor for simulation, optimization and prediction workloads, created on first use
+    static ThreadPool& shared();
+    // Sizes the shared executor; only effective before its first use. Returns false once it exists.
+    static bool configureShared(size_t threadCount, bool pinThreads = false);
+};
+
+#endif // THREAD_POOL_HPP
@@ -1,7 +1,13 @@
 #include "SpindleSimulation.hpp"
+#include "BenchmarkHarness.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
 #include <iostream>
 #include <iomanip>
 #include <limits>
+#include <numeric>
+#include <sstream>
 #include <stdexcept>
 
 void clearInputBuffer() {
@@ -32,6 +38,21 @@ std::string getChoiceInput(const std::string& prompt, const std::vector<std::str
     return options[choice - 1];
 }
 
+std::string getTextInput(const std::string& prompt) {
+    std::cout << prompt;
+    std::string value;
+    std::getline(std::cin, value);
+    return value;
+}
+
+SearchAlgorithm getSearchAlgorithm() {
+    std::string algorithm = getChoiceInput("Select Search Algorithm:", {"NSGA-II", "GDE3", "MOPSO", "Portfolio"});
+    if (algorithm == "GDE3") return SearchAlgorithm::Gde3;
+    if (algorithm == "MOPSO") return SearchAlgorithm::Mopso;
+    if (algorithm == "Portfolio") return SearchAlgorithm::Portfolio;
+    return SearchAlgorithm::Nsga2;
+}
+
 SpindleParameters getParameters() {
     SpindleParameters params;
 
@@ -98,10 +119,15 @@ int main() {
             std::cout << "3. Generate Maintenance Schedule\n";
             std::cout << "4. Predict Maintenance\n";
             std::cout << "5. Optimize Spindle Arrangement\n";
-            std::cout << "6. Exit\n";
-            int choice = getNumericInput("Enter choice (1-6): ", 1, 6);
+            std::cout << "6. Run Optimizer Benchmarks\n";
+            std::cout << "7. Run Replicate Optimization Study\n";
+            std::cout << "8. Import Maintenance History\n";
+            std::cout << "9. Run History Concurrency Benchmark\n";
+            std::cout << "10. Train Maintenance Model\n";
+            std::cout << "11. Exit\n";
+            int choice = getNumericInput("Enter choice (1-11): ", 1, 11);
 
-            if (choice == 6) break;
+            if (choice == 11) break;
 
             try {
                 if (choice == 1) {
@@ -120,7 +146,70 @@ int main() {
                 } else if (choice == 5) {
                     double duration = getNumericInput("Enter Simulation Duration (s, >0): ", 0.1, 1000.0);
                     double loadFactor = getNumericInput("Enter Load Factor (0.5-2.0): ", 0.5, 2.0);
-                    std::cout << sim.optimizeSpindleArrangement(duration, loadFactor, 50, 20) << "\n";
+                    OptimizationSettings settings;
+                    settings.algorithm = getSearchAlgorithm();
+                    settings.timeLimitSeconds = getNumericInput("Enter Time Limit (s, 0 for none): ", 0.0, 86400.0);
+                    if (getChoiceInput("Focus the search on a region of interest?", {"No", "Yes"}) == "Yes") {
+                        double vibration = getNumericInput("Enter Target Vibration (mm/s, 0.01-10): ", 0.01, 10.0);
+                        double bearingLife = getNumericInput("Enter Target Bearing Life (hours, 1000-1000000): ", 1000.0, 1000000.0);
+                        double temperature = getNumericInput("Enter Target Temperature Rise (°C, 1-100): ", 1.0, 100.0);
+                        settings.referencePoints.push_back({vibration, bearingLife, temperature});
+                    }
+                    settings.warmStartPath = getTextInput("Warm-start front file (empty for none): ");
+                    settings.frontExportPath = getTextInput("Export Pareto front to file (empty for none): ");
+                    settings.metricsExportPath = getTextInput("Export per-generation front metrics to .csv/.json (empty for none): ");
+                    std::cout << "Optimizing; progress is logged to optimization_log.txt\n";
+                    std::cout << sim.optimizeSpindleArrangement(duration, loadFactor, 50, 20, settings) << "\n";
+                } else if (choice == 6) {
+                    BenchmarkSettings settings;
+                    settings.populationSize = getNumericInput("Enter Population Size (10-500): ", 10, 500);
+                    settings.generations = getNumericInput("Enter Generations (1-2000): ", 1, 2000);
+                    settings.seeds.resize(getNumericInput("Enter Runs per Problem (1-30): ", 1, 30));
+                    std::iota(settings.seeds.begin(), settings.seeds.end(), 1u);
+                    settings.optimizer.algorithm = getSearchAlgorithm();
+                    std::istringstream problems(getTextInput("Problems to run, comma-separated (empty for all): "));
+                    std::string name;
+                    while (std::getline(problems, name, ',')) {
+                        name.erase(0, name.find_first_not_of(' '));
+                        name.erase(name.find_last_not_of(' ') + 1);
+                        std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+                        if (!name.empty()) settings.problems.push_back(name);
+                    }
+                    std::cout << runBenchmarkSuite(settings) << "\n";
+                } else if (choice == 7) {
+                    std::cout << sim.runReplicateStudy(getTextInput("Enter job file path: ")) << "\n";
+                } else if (choice == 8) {
+                    HistoryImportOptions options;
+                    std::string path = getTextInput("Enter CSV file path: ");
+                    options.hasHeader = getChoiceInput("Does the first line name the columns?", {"Yes", "No"}) == "Yes";
+                    HistoryImportReport report = sim.importMaintenanceHistory(path, options);
+                    std::cout << std::fixed << std::setprecision(2);
+                    std::cout << "Imported " << report.rowsImported << " rows, rejected " << report.rowsRejected << " in "
+                              << report.seconds << " s (" << report.bytes / 1e6 / std::max(report.seconds, 1e-9) << " MB/s)\n";
+                    for (const HistoryImportError& error : report.errors) {
+                        std::cout << "Line " << error.line << ": " << error.reason << "\n";
+                    }
+                } else if (choice == 9) {
+                    HistoryBenchmarkSettings settings;
+                    settings.records = getNumericInput("Enter History Size (1000-10000000): ", size_t(1000), size_t(10000000));
+                    settings.writers = getNumericInput("Enter Writer Threads (0-64): ", size_t(0), size_t(64));
+                    settings.seconds = getNumericInput("Enter Seconds per Phase (0.1-60): ", 0.1, 60.0);
+                    if (getChoiceInput("Select Neighbour Search:", {"kd-tree", "HNSW"}) == "HNSW") settings.search = NeighborSearch::Hnsw;
+                    std::cout << runHistoryBenchmark(settings) << "\n";
+                } else if (choice == 10) {
+                    ClassifierSettings settings;
+                    std::string model = getChoiceInput("Select Maintenance Model:", {"Nearest neighbours", "Logistic regression", "Boosted trees"});
+                    if (model == "Nearest neighbours") settings.model = MaintenanceModel::Neighbors;
+                    else if (model == "Logistic regression") settings.model = MaintenanceModel::Logistic;
+                    auto started = std::chrono::steady_clock::now();
+                    std::shared_ptr<const MaintenanceClassifier> trained = sim.trainMaintenanceModel(settings);
+                    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+                    if (trained) {
+                        std::cout << std::fixed << std::setprecision(2) << "Trained on " << trained->trainingRecords() << " records in "
+                                  << seconds << " s, training accuracy " << trained->trainingAccuracy() * 100.0 << "%\n";
+                    } else {
+                        std::cout << "Predicting from the nearest history records\n";
+                    }
                 }
             } catch (const std::exception& e) {
                 std::cerr << "Error: " << e.what() << "\n";